@@ -10,6 +10,12 @@ extern "C"
     typedef struct page_base_t page_base_t;
     typedef struct page_manager_t page_manager_t;
 
+    /* 页面句柄,由pm_install返回;低16位是页面表下标,高16位是槽位的代数,
+     * 页面卸载后旧句柄失效,不会指向之后安装在同一槽位的页面 */
+    typedef uint32_t pm_page_id_t;
+
+#define PM_PAGE_ID_INVALID ((pm_page_id_t)0xFFFFFFFF)
+
     typedef enum
     {
         PAGE_STATE_IDLE,
@@ -20,6 +26,7 @@ extern "C"
         PAGE_STATE_WILL_DISAPPEAR,
         PAGE_STATE_DID_DISAPPEAR,
         PAGE_STATE_UNLOAD,
+        PAGE_STATE_LOADING, // 分帧构建中,退出动画同时播放
         _PAGE_STATE_LAST
     } page_state_t;
 
@@ -30,6 +37,60 @@ extern "C"
         uint32_t size;
     } page_stash_t;
 
+    // 数据块存储方式
+    typedef enum
+    {
+        PAGE_STASH_NONE,   // 没有数据块
+        PAGE_STASH_INLINE, // 存放在页面对象内
+        PAGE_STASH_POOL,   // 存放在页面管理器的数据块内存池中
+        PAGE_STASH_HEAP,   // 超过内存池最大分级,直接申请
+        PAGE_STASH_MOVED,  // 调用者转交的数据块,由释放回调回收
+        PAGE_STASH_SHARED, // 引用计数的共享数据块
+    } page_stash_type_t;
+
+    // 数据块释放回调
+    typedef void (*page_stash_free_cb_t)(void *ptr);
+
+    // 共享数据块
+    typedef struct pm_shared_buf_t pm_shared_buf_t;
+
+    // 页面生命周期统计项
+    typedef enum
+    {
+        PM_STAT_LOAD,            // on_view_load耗时
+        PM_STAT_DID_LOAD,        // on_view_did_load耗时
+        PM_STAT_WILL_APPEAR,     // on_view_will_appear耗时
+        PM_STAT_TRANSITION,      // 从on_view_will_appear开始到on_view_did_appear结束
+        PM_STAT_FIRST_FRAME,     // 从切换请求到进入动画开始,即第一帧可以绘制
+        PM_STAT_APPEAR_CACHED,   // 从切换请求到on_view_did_appear结束,页面已缓存
+        PM_STAT_APPEAR_UNCACHED, // 从切换请求到on_view_did_appear结束,页面未缓存
+        _PM_STAT_LAST
+    } pm_stat_metric_t;
+
+/* 耗时直方图的桶数量,第i个桶的上限为(500us << i),最后一个桶收集更大的值 */
+#define PM_STAT_BUCKETS 10
+
+    // 单项耗时统计
+    typedef struct
+    {
+        uint32_t count;                    // 次数
+        uint32_t max_us;                   // 最大耗时
+        uint64_t sum_us;                   // 总耗时
+        uint16_t buckets[PM_STAT_BUCKETS]; // 耗时直方图,计数饱和不回绕
+    } pm_stat_hist_t;
+
+    // 页面耗时统计
+    typedef struct
+    {
+        pm_stat_hist_t hist[_PM_STAT_LAST];
+    } pm_page_stats_t;
+
+    // 微秒时钟回调
+    typedef uint32_t (*pm_clock_cb_t)(void);
+
+    // 页面快照回调,返回与根对象同级、内容为根对象渲染结果的对象(如lv_img),失败返回NULL
+    typedef lv_obj_t *(*pm_snapshot_cb_t)(page_base_t *page);
+
     // 页面切换动画属性
     typedef struct
     {
@@ -87,8 +148,34 @@ extern "C"
          *  @note 页面被卸载的时候会被调用,is_cache是true时跳过
          */
         void (*on_view_did_unload)(page_base_t *self);
+
+        /**
+         * @brief 分帧构建页面,可为NULL
+         *  @note on_view_load之后每帧在时间预算内被反复调用,每次构建一部分控件,
+         *        返回true表示构建完成;期间根对象隐藏,上一个页面的退出动画同时播放,
+         *        构建完成后再调用on_view_did_load并开始进入动画
+         */
+        bool (*on_view_load_step)(page_base_t *self);
+
+        /**
+         * @brief 保存页面状态,可为NULL
+         *  @note 页面栈中的缓存页面因超出缓存预算或超时被淘汰前调用,
+         *        用于保存滚动位置、输入内容等,根对象随后被删除
+         */
+        void (*on_save_state)(page_base_t *self);
+
+        /**
+         * @brief 恢复页面状态,可为NULL
+         *  @note 被淘汰的页面在pop时重新加载,on_view_did_load之后调用
+         */
+        void (*on_restore_state)(page_base_t *self);
     } page_vtable_t;
 
+    /**
+     * 页面对象存放在页面管理器的页面表中,
+     * 状态机每次切换都会访问的热数据(状态、缓存、动画忙碌、入栈标志)
+     * 以结构数组的形式存放在page_manager_t::page_hot中,通过页面句柄索引
+     */
     typedef struct page_base_t
     {
         page_vtable_t* base;
@@ -97,19 +184,52 @@ extern "C"
         page_manager_t *manager;
         const char *name;
         void *user_data;
+        pm_page_id_t id;           // 页面句柄,低16位是页面在页面表中的下标
+        uint32_t name_hash;        // 页面名称哈希
+        page_base_t *hash_next;    // 注册表哈希桶链表
+#if PAGE_MANAGER_USE_STATS
+        struct
+        {
+            pm_page_stats_t data;  // 耗时统计
+            uint32_t appear_tick;  // on_view_will_appear开始的时间
+            bool is_cached;        // 切换请求时页面是否已缓存
+        } stats;
+#endif
         struct
         {
             bool req_enable_cache;       // 页面缓存启用标志位
             bool req_disable_auto_cache; // 页面自动缓存管理启用标志位
             bool is_disable_auto_cache;  // 页面自动缓存标志位
-            bool is_cached;              // 页面缓存标志位
             page_stash_t stash;          // push时传入参数
-            page_state_t state;          // 页面状态
+            uint8_t stash_type;          // 数据块存储方式(page_stash_type_t)
+            uint8_t stash_class;         // 数据块所在的内存池分级
+            union
+            {
+                uint8_t buf[PAGE_MANAGER_STASH_INLINE_SIZE];
+                void *align_ptr;
+                double align_double;
+            } stash_inline;              // 数据块内联存储区
+            union
+            {
+                page_stash_free_cb_t free_cb; // 转交数据块的释放回调
+                pm_shared_buf_t *shared;      // 引用的共享数据块
+            } stash_owner;
+            page_base_t *stack_next;     // 页面栈中的下一个(更靠近栈底的)页面
+            uint8_t priority;            // 页面优先级,大于0时push会打断正在播放的切换动画
+            uint8_t preload;             // 预加载状态
+            uint32_t load_tick;          // 开始分帧构建的时间
+            bool is_pinned;              // 缓存固定,不会被淘汰
+            bool is_evicted;             // 在页面栈中被淘汰,pop时重新加载并恢复状态
+            uint16_t cache_objs;         // 隐藏时根对象下的lvgl对象数量
+            uint32_t cache_tick;         // 隐藏的时间(ms)
+            bool is_occluded;            // 根对象被当前页面完全遮挡而隐藏
+            bool is_opaque;              // 用户声明页面内容不透明且覆盖整个显示区域
             /* 动画状态  */
             struct
             {
                 bool is_enter;         // 进入还是退出动画
-                bool is_busy;          // 动画是否正在播放
+                bool is_interrupted;   // 上一次切换动画被打断,根对象停在中间位置
+                lv_obj_t *snapshot;    // 切换动画期间代替根对象移动的快照
                 page_anim_attr_t attr; // lvgl动画属性
             } anim;
         } priv;
@@ -149,6 +269,35 @@ extern "C"
      */
     void page_set_custom_root_event_cb(page_base_t *self, lv_event_cb_t root_event_cb);
 
+    /**
+     * @brief 设置页面优先级
+     *  @note 优先级大于0的页面(如闹钟、告警)push时不排队,立即打断正在播放的切换动画,
+     *        缓存淘汰时优先淘汰优先级低的页面
+     *
+     * @param self 页面对象
+     * @param priority 优先级,默认0
+     */
+    void page_set_custom_priority(page_base_t *self, uint8_t priority);
+
+    /**
+     * @brief 固定页面缓存
+     *  @note 固定的页面不会因为缓存预算或超时被淘汰
+     *
+     * @param self 页面对象
+     * @param en 是否固定
+     */
+    void page_set_custom_cache_pin(page_base_t *self, bool en);
+
+    /**
+     * @brief 声明页面不透明
+     *  @note 默认只有根对象背景和opa_scale都完全不透明、尺寸覆盖整个显示区域时才遮挡下层页面;
+     *        根对象背景透明、由子对象铺满整个页面时可以开启
+     *
+     * @param self 页面对象
+     * @param en 是否不透明,默认false
+     */
+    void page_set_custom_opaque(page_base_t *self, bool en);
+
     /**
      * @brief 获取缓存区里的数据,这里的缓存区是页面push的时候存放自己的数据
      *
@@ -160,6 +309,16 @@ extern "C"
      */
     bool page_get_stash(page_base_t *self, void *ptr, uint32_t size);
 
+    /**
+     * @brief 借用缓存区里的数据,不复制
+     *  @note 返回的指针在页面卸载或下一次push之前有效
+     *
+     * @param self 页面对象
+     * @param size [out]数据长度,可为NULL
+     * @return const void* 数据地址,没有数据时返回NULL
+     */
+    const void *page_borrow_stash(page_base_t *self, uint32_t *size);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
\ No newline at end of file
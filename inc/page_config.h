@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #ifdef LV_LVGL_H_INCLUDE_SIMPLE
 #include "lvgl.h"
@@ -11,24 +12,148 @@
 #include "lvgl/lvgl.h"
 #endif
 
+/* 带#ifndef的开关可以由构建系统通过-D覆盖,见CMakeLists.txt */
+
+/* 默认分配器(PM_MALLOC/PM_FREE/PM_REALLOC)的后端: 1 lvgl的lv_mem堆; 0 libc的malloc/free */
+#ifndef PAGE_MANAGER_USE_GC
 #define PAGE_MANAGER_USE_GC 0
+#endif
+#ifndef PAGE_MANAGER_USE_LOG
 #define PAGE_MANAGER_USE_LOG 1
+#endif
+
+/* 页面管理器最多可安装的页面数量,页面表在创建页面管理器时一次性申请,页面较多的工程可通过-D调大 */
+#ifndef PAGE_MANAGER_PAGE_MAX
+#define PAGE_MANAGER_PAGE_MAX 64
+#endif
+/* 页面注册表哈希桶数量,必须是2的幂,建议不小于PAGE_MANAGER_PAGE_MAX的1/4 */
+#ifndef PAGE_MANAGER_HASH_SIZE
+#define PAGE_MANAGER_HASH_SIZE 64
+#endif
+
+#if PAGE_MANAGER_PAGE_MAX <= 0 || PAGE_MANAGER_PAGE_MAX >= 0xFFFF
+#error "PAGE_MANAGER_PAGE_MAX must be in [1, 0xFFFE]"
+#endif
+#if (PAGE_MANAGER_HASH_SIZE & (PAGE_MANAGER_HASH_SIZE - 1)) != 0
+#error "PAGE_MANAGER_HASH_SIZE must be a power of 2"
+#endif
+
+/* 数据块内联存储的最大字节数,不超过该大小的数据块直接存放在页面对象中 */
+#define PAGE_MANAGER_STASH_INLINE_SIZE 32
+/* 数据块内存池的分级数量,从内联大小的2倍开始逐级翻倍,更大的数据块直接申请 */
+#define PAGE_MANAGER_STASH_POOL_CLASSES 6
+
+/* 导航请求队列长度,页面切换期间的push/pop/replace请求放入队列,切换结束后依次执行; 0 关闭,切换期间的请求被丢弃 */
+#define PAGE_MANAGER_NAV_QUEUE_SIZE 8
+
+/* 预加载每帧最多占用的时间(us),分帧构建的页面按on_view_load_step切分,至少调用一次 */
+#define PAGE_MANAGER_PRELOAD_BUDGET_US 8000
+/* 预加载任务的运行周期(ms) */
+#define PAGE_MANAGER_PRELOAD_PERIOD 30
+
+/* 分帧构建页面时每帧最多占用的时间(us),至少调用一次on_view_load_step */
+#define PAGE_MANAGER_LOAD_BUDGET_US 8000
+/* 分帧构建的期限(us),超过后剩余部分一次构建完成并开始进入动画 */
+#define PAGE_MANAGER_LOAD_DEADLINE_US 300000
+/* 分帧构建任务的运行周期(ms) */
+#define PAGE_MANAGER_LOAD_PERIOD 10
+
+/* 缓存预算: 隐藏的缓存页面最多持有的lvgl对象数量,超出时按优先级和最近最少使用淘汰; 0 不限制 */
+#define PAGE_MANAGER_CACHE_MAX_OBJS 0
+/* 缓存页面隐藏超过该时间(ms)后被淘汰; 0 不按时间淘汰 */
+#define PAGE_MANAGER_CACHE_TTL 0
+/* 检查缓存超时的任务周期(ms) */
+#define PAGE_MANAGER_CACHE_CHECK_PERIOD 1000
+
+/* 切换动画类型注册表容量,包括内置的动画类型 */
+#define PAGE_MANAGER_ANIM_TYPE_MAX 16
 
 #if PAGE_MANAGER_USE_GC
-#define PM_MALLOC(x) lv_mem_alloc(x);
-#define FREE(x) lv_men_free(x)
+#define PM_MALLOC(x) lv_mem_alloc(x)
+#define PM_FREE(x) lv_mem_free(x)
+#define PM_REALLOC(p, x) lv_mem_realloc(p, x)
 #else
-#define PM_MALLOC(x) malloc(x);
+#define PM_MALLOC(x) malloc(x)
 #define PM_FREE(x) free(x)
+#define PM_REALLOC(p, x) realloc(p, x)
 #endif
 
-#if PAGE_MANAGER_USE_LOG
-#define _PM_LOG(format, ...) printf("[PM]" format "\r\n", ##__VA_ARGS__)
-#define PM_LOG_INFO(format, ...) _PM_LOG("[Info] " format, ##__VA_ARGS__)
-#define PM_LOG_WARN(format, ...) _PM_LOG("[Warn] " format, ##__VA_ARGS__)
-#define PM_LOG_ERROR(format, ...) _PM_LOG("[Error] " format, ##__VA_ARGS__)
-#else
-#define PM_LOG_INFO(...)
-#define PM_LOG_WARN(...)
-#define PM_LOG_ERROR(...)
+/* 页面生命周期耗时统计,每个页面约占用300字节 */
+#ifndef PAGE_MANAGER_USE_STATS
+#define PAGE_MANAGER_USE_STATS 0
 #endif
+/* 统计/trace使用的微秒时钟,默认由lv_tick_get()换算,精度1ms,运行时可通过pm_set_clock()替换为硬件定时器或测试时钟 */
+#ifndef PM_TICK_US
+#define PM_TICK_US() pm_clock_us()
+#endif
+
+/* 导航trace,状态切换/切换动画/拖拽事件写入Chrome/Perfetto JSON文件,Linux下同时提供USDT探针 */
+#ifndef PAGE_MANAGER_USE_TRACE
+#define PAGE_MANAGER_USE_TRACE 0
+#endif
+
+/* 日志等级 */
+#define PM_LOG_LEVEL_INFO 0
+#define PM_LOG_LEVEL_WARN 1
+#define PM_LOG_LEVEL_ERROR 2
+#define PM_LOG_LEVEL_NONE 3
+
+/* 全局日志等级,低于该等级的日志在编译时被移除 */
+#ifndef PAGE_MANAGER_LOG_LEVEL
+#define PAGE_MANAGER_LOG_LEVEL PM_LOG_LEVEL_INFO
+#endif
+
+/* 各模块日志等级 */
+#ifndef PAGE_MANAGER_LOG_LEVEL_MANAGER
+#define PAGE_MANAGER_LOG_LEVEL_MANAGER PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_ROUTER
+#define PAGE_MANAGER_LOG_LEVEL_ROUTER PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_STATE
+#define PAGE_MANAGER_LOG_LEVEL_STATE PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_ANIM
+#define PAGE_MANAGER_LOG_LEVEL_ANIM PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_DRAG
+#define PAGE_MANAGER_LOG_LEVEL_DRAG PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_BASE
+#define PAGE_MANAGER_LOG_LEVEL_BASE PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_MEM
+#define PAGE_MANAGER_LOG_LEVEL_MEM PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_STASH
+#define PAGE_MANAGER_LOG_LEVEL_STASH PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_STATS
+#define PAGE_MANAGER_LOG_LEVEL_STATS PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_TRACE
+#define PAGE_MANAGER_LOG_LEVEL_TRACE PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_QUEUE
+#define PAGE_MANAGER_LOG_LEVEL_QUEUE PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_PRELOAD
+#define PAGE_MANAGER_LOG_LEVEL_PRELOAD PAGE_MANAGER_LOG_LEVEL
+#endif
+#ifndef PAGE_MANAGER_LOG_LEVEL_CACHE
+#define PAGE_MANAGER_LOG_LEVEL_CACHE PAGE_MANAGER_LOG_LEVEL
+#endif
+
+/* 延迟日志: 1 日志以二进制记录写入环形缓冲区,由pm_log_flush()在空闲时格式化输出; 0 直接printf */
+#ifndef PAGE_MANAGER_LOG_DEFERRED
+#define PAGE_MANAGER_LOG_DEFERRED 0
+#endif
+/* 延迟日志环形缓冲区的记录条数,必须是2的幂 */
+#ifndef PAGE_MANAGER_LOG_BUF_SIZE
+#define PAGE_MANAGER_LOG_BUF_SIZE 128
+#endif
+#if (PAGE_MANAGER_LOG_BUF_SIZE & (PAGE_MANAGER_LOG_BUF_SIZE - 1)) != 0
+#error "PAGE_MANAGER_LOG_BUF_SIZE must be a power of 2"
+#endif
+
+#include "page_log.h"
@@ -0,0 +1,132 @@
+#pragma once
+
+/* 由page_config.h包含,源文件可在包含头文件前定义PM_LOG_MODULE_LEVEL指定本模块的日志等级 */
+
+#ifndef PM_LOG_MODULE_LEVEL
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* 单条日志最多记录的参数个数,超出的参数丢弃 */
+#define PM_LOG_ARG_MAX 4
+
+/* 单条日志中%s参数复制的字符串总长度,超出部分截断 */
+#ifndef PM_LOG_STR_SIZE
+#define PM_LOG_STR_SIZE 16
+#endif
+
+/* %s参数为NULL时记录的值 */
+#define PM_LOG_STR_NULL UINTPTR_MAX
+
+/* 调用处的%s参数掩码尚未计算 */
+#define PM_LOG_MASK_UNSET 0xFF
+
+    /* 延迟日志记录 */
+    typedef struct
+    {
+        const char *format; // 格式字符串,同时作为格式ID供主机端解码
+        uint32_t tick;      // 时间戳(ms)
+        uint8_t level;      // 日志等级
+        uint8_t argc;       // 参数个数
+        uintptr_t args[PM_LOG_ARG_MAX]; // 参数,%s参数为字符串在str中的偏移,NULL为PM_LOG_STR_NULL
+        char str[PM_LOG_STR_SIZE];      // 写入时复制的%s参数,以'\0'分隔
+    } pm_log_record_t;
+
+    /**
+     * @brief 计算格式字符串中%s参数的位置掩码
+     *  @note 每个调用处只计算一次,结果保存在_PM_LOG宏中的静态变量里
+     *
+     * @param format 格式字符串
+     * @return uint8_t 第i个参数为%s时第i位为1
+     */
+    uint8_t pm_log_str_mask(const char *format);
+
+    /**
+     * @brief 写入一条延迟日志记录
+     *
+     * @param level 日志等级
+     * @param format 格式字符串,必须是字符串常量
+     * @param str_mask %s参数的位置掩码,由pm_log_str_mask()计算
+     * @param argc 参数个数
+     * @param args 参数,args[0]为占位,参数从args[1]开始
+     */
+    void pm_log_write(uint8_t level, const char *format, uint8_t str_mask, uint8_t argc, const uintptr_t *args);
+
+    /**
+     * @brief 取出一条延迟日志记录,用于把原始记录发送给主机端解码
+     *
+     * @param record [out]日志记录
+     * @return true 取出成功
+     * @return false 缓冲区为空
+     */
+    bool pm_log_read(pm_log_record_t *record);
+
+    /**
+     * @brief 格式化并输出缓冲区中的所有延迟日志,在空闲时调用
+     *
+     * @return uint32_t 输出的日志条数
+     */
+    uint32_t pm_log_flush(void);
+
+    /**
+     * @brief 获取因缓冲区满而丢弃的日志条数
+     *
+     * @return uint32_t 丢弃的日志条数
+     */
+    uint32_t pm_log_get_dropped(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#if PAGE_MANAGER_USE_LOG
+#if PAGE_MANAGER_LOG_DEFERRED
+#define _PM_LOG_NARG(...) _PM_LOG_NARG_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define _PM_LOG_NARG_(_0, _1, _2, _3, _4, _5, _6, N, ...) N
+#define _PM_LOG_CAT(a, b) _PM_LOG_CAT_(a, b)
+#define _PM_LOG_CAT_(a, b) a##b
+#define _PM_LOG_ARGS_0()
+#define _PM_LOG_ARGS_1(a) , (uintptr_t)(a)
+#define _PM_LOG_ARGS_2(a, b) , (uintptr_t)(a), (uintptr_t)(b)
+#define _PM_LOG_ARGS_3(a, b, c) , (uintptr_t)(a), (uintptr_t)(b), (uintptr_t)(c)
+#define _PM_LOG_ARGS_4(a, b, c, d) , (uintptr_t)(a), (uintptr_t)(b), (uintptr_t)(c), (uintptr_t)(d)
+#define _PM_LOG_ARGS_5(a, b, c, d, e) , (uintptr_t)(a), (uintptr_t)(b), (uintptr_t)(c), (uintptr_t)(d), (uintptr_t)(e)
+#define _PM_LOG_ARGS_6(a, b, c, d, e, f) , (uintptr_t)(a), (uintptr_t)(b), (uintptr_t)(c), (uintptr_t)(d), (uintptr_t)(e), (uintptr_t)(f)
+#define _PM_LOG(level, format, ...)                                                  \
+    do                                                                               \
+    {                                                                                \
+        static uint8_t _pm_log_mask = PM_LOG_MASK_UNSET;                             \
+        if (_pm_log_mask == PM_LOG_MASK_UNSET)                                       \
+        {                                                                            \
+            _pm_log_mask = pm_log_str_mask(format);                                  \
+        }                                                                            \
+        pm_log_write(level, format, _pm_log_mask, _PM_LOG_NARG(__VA_ARGS__),         \
+                     (const uintptr_t[]){0 _PM_LOG_CAT(_PM_LOG_ARGS_,                \
+                                                       _PM_LOG_NARG(__VA_ARGS__))(__VA_ARGS__)}); \
+    } while (0)
+#else
+#define _PM_LOG(level, format, ...) printf("[PM]" format "\r\n", ##__VA_ARGS__)
+#endif
+#endif
+
+#if PAGE_MANAGER_USE_LOG && PM_LOG_MODULE_LEVEL <= PM_LOG_LEVEL_INFO
+#define PM_LOG_INFO(format, ...) _PM_LOG(PM_LOG_LEVEL_INFO, "[Info] " format, ##__VA_ARGS__)
+#else
+#define PM_LOG_INFO(...)
+#endif
+
+#if PAGE_MANAGER_USE_LOG && PM_LOG_MODULE_LEVEL <= PM_LOG_LEVEL_WARN
+#define PM_LOG_WARN(format, ...) _PM_LOG(PM_LOG_LEVEL_WARN, "[Warn] " format, ##__VA_ARGS__)
+#else
+#define PM_LOG_WARN(...)
+#endif
+
+#if PAGE_MANAGER_USE_LOG && PM_LOG_MODULE_LEVEL <= PM_LOG_LEVEL_ERROR
+#define PM_LOG_ERROR(format, ...) _PM_LOG(PM_LOG_LEVEL_ERROR, "[Error] " format, ##__VA_ARGS__)
+#else
+#define PM_LOG_ERROR(...)
+#endif
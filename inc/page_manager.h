@@ -1,7 +1,7 @@
 #pragma once
 
-#include "adlist.h"
 #include "page_base.h"
+#include "page_mem.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -67,6 +67,17 @@ extern "C"
         } exit;
     } page_anim_value_t;
 
+    /* 切换动画播放期间收到新的导航请求时的处理方式 */
+    typedef enum
+    {
+        PM_PREEMPT_NONE,     // 等待动画结束,请求放入导航队列
+        PM_PREEMPT_RETARGET, // 动画停在当前位置,新的切换从当前位置开始
+        PM_PREEMPT_FINISH,   // 动画直接跳到终点,再开始新的切换
+    } pm_preempt_t;
+
+    /* 动画结束后释放setter留下的样式,返回true表示页面已不可见,需要隐藏 */
+    typedef bool (*lv_anim_release_t)(lv_obj_t *);
+
     /* 页面加载动画属性 */
     typedef struct
     {
@@ -75,12 +86,101 @@ extern "C"
         page_root_drag_dir_t drag_dir;
         page_anim_value_t push;
         page_anim_value_t pop;
+        lv_anim_release_t release;
+        bool is_partial;
     } page_load_anim_attr_t;
 
+    /* 动画数值的单位 */
+    typedef enum
+    {
+        PM_ANIM_UNIT_VALUE, // 直接作为setter的参数,如透明度、缩放
+        PM_ANIM_UNIT_HOR,   // 显示区域宽度的千分比
+        PM_ANIM_UNIT_VER,   // 显示区域高度的千分比
+    } pm_anim_unit_t;
+
+    /* 切换动画类型描述,内置的动画类型和pm_register_anim_type()注册的动画类型使用同一张表 */
+    typedef struct
+    {
+        lv_anim_setter_t setter;       // 作用在页面根对象上,只有内置的LOAD_ANIM_NONE为NULL
+        lv_anim_getter_t getter;       // 读取当前值,拖拽和被打断的动画从该值继续,只有内置的LOAD_ANIM_NONE为NULL
+        page_root_drag_dir_t drag_dir; // 拖拽返回的方向,ROOT_DRAG_DIR_NONE不支持拖拽
+        uint8_t unit;                  // 数值单位(pm_anim_unit_t)
+        page_anim_value_t push;        // push时进入/退出页面的起止值
+        page_anim_value_t pop;         // pop时进入/退出页面的起止值
+        lv_anim_release_t release;     // 动画结束后调用,可为NULL
+        bool is_partial;               // 重绘区域提示: 动画结束后页面没有覆盖整个显示区域,下层页面不隐藏
+    } pm_anim_type_t;
+
+    /* 页面管理器内存统计 */
+    typedef struct
+    {
+        uint32_t alloc_count;        // 累计申请次数
+        uint32_t free_count;         // 累计释放次数
+        uint32_t bytes_used;         // 当前占用字节数
+        uint32_t bytes_peak;         // 占用字节数峰值
+        uint32_t locked_alloc_count; // 锁定期间的申请次数
+    } pm_alloc_stat_t;
+
+    /* 导航请求类型 */
+    typedef enum
+    {
+        PM_NAV_PUSH,    // 推送页面
+        PM_NAV_REPLACE, // 替换栈顶页面
+        PM_NAV_POP,     // 回退n层
+        PM_NAV_POP_TO,  // 回退到指定页面
+        PM_NAV_HOME,    // 返回栈底页面
+    } pm_nav_type_t;
+
+    /* 导航请求携带的数据块,请求执行时才交给页面 */
+    typedef struct
+    {
+        page_stash_t stash; // 数据块
+        uint8_t type;       // 存储方式(page_stash_type_t),复制的数据块为PAGE_STASH_HEAP
+        union
+        {
+            page_stash_free_cb_t free_cb; // 转交数据块的释放回调
+            pm_shared_buf_t *shared;      // 引用的共享数据块
+        } owner;
+    } pm_nav_stash_t;
+
+    /* 导航请求 */
+    typedef struct
+    {
+        uint8_t type;         // 请求类型(pm_nav_type_t)
+        pm_page_id_t id;      // 目标页面句柄
+        uint16_t n;           // 回退层数
+        pm_nav_stash_t stash; // push/replace请求的数据块
+    } pm_nav_cmd_t;
+
+    /* 页面管理器运行状况,长时间运行时定期采样,数值持续增长说明存在泄漏 */
+    typedef struct
+    {
+        uint16_t page_count;       // 已安装页面数量
+        uint16_t stack_depth;      // 页面堆栈深度
+        uint16_t root_count;       // 持有根对象的页面数量(显示中或已缓存)
+        uint16_t stash_count;      // 持有数据块的页面数量
+        uint16_t shared_buf_count; // 未释放的共享数据块数量
+        uint32_t stash_pool_free;  // 数据块内存池中空闲的存储区数量
+        uint32_t bytes_used;       // 当前占用字节数
+        uint32_t cache_obj_count;  // 隐藏的缓存页面持有的lvgl对象数量
+    } pm_health_t;
+
     typedef struct page_manager_t
     {
-        list *page_pool;           // 页面池，用于注册页面
-        list *page_stack;          // 页面堆栈，用于收集页面进入方式并依次退出
+        page_base_t *page_table;   // 页面表，连续存放所有页面对象，按页面句柄索引
+        /* 页面热数据，按页面句柄索引 */
+        struct
+        {
+            uint8_t state[PAGE_MANAGER_PAGE_MAX];    // 页面状态(page_state_t)
+            bool is_cached[PAGE_MANAGER_PAGE_MAX];   // 页面缓存标志位
+            bool is_busy[PAGE_MANAGER_PAGE_MAX];     // 动画是否正在播放
+            bool is_in_stack[PAGE_MANAGER_PAGE_MAX]; // 页面是否在页面栈中
+        } page_hot;
+        uint16_t page_generation[PAGE_MANAGER_PAGE_MAX]; // 页面表槽位的代数,页面卸载时加1,用于识别失效的页面句柄
+        page_base_t *page_hash[PAGE_MANAGER_HASH_SIZE]; // 页面注册表，按页面名称哈希索引
+        uint16_t page_count;       // 已安装页面数量
+        page_base_t *stack_top;    // 页面堆栈栈顶，用于收集页面进入方式并依次退出
+        uint16_t stack_depth;      // 页面堆栈深度
         page_base_t *page_prev;    // 上一个页面节点
         page_base_t *page_current; // 当前页面节点
         struct
@@ -88,9 +188,39 @@ extern "C"
             bool is_switch_req;       // 是否切换请求
             bool is_busy;             // 忙碌标志位
             bool is_pushing;          // 是否处于压栈状态
+            uint8_t preempt;          // 切换动画被新请求打断的方式(pm_preempt_t)
             page_anim_attr_t current; // 当前动画属性
             page_anim_attr_t global;  // 全局动画属性
         } anim_state;
+#if PAGE_MANAGER_NAV_QUEUE_SIZE > 0
+        struct
+        {
+            pm_nav_cmd_t cmd[PAGE_MANAGER_NAV_QUEUE_SIZE]; // 环形队列
+            uint8_t head;                                  // 队首下标
+            uint8_t count;                                 // 请求数量
+        } nav_queue;
+#endif
+        void *stash_pool[PAGE_MANAGER_STASH_POOL_CLASSES]; // 数据块内存池空闲链表，按大小分级
+        uint16_t shared_buf_count; // 未释放的共享数据块数量
+        lv_disp_t *disp;           // 绑定的显示器,NULL时为默认显示器
+        lv_obj_t *parent;          // 页面根对象的父对象,NULL时为显示器的活动屏幕
+        const pm_anim_type_t *anim_types[PAGE_MANAGER_ANIM_TYPE_MAX];      // 动画类型注册表,按动画类型索引
+        page_load_anim_attr_t anim_attr_table[PAGE_MANAGER_ANIM_TYPE_MAX]; // 各动画类型的属性,按动画类型索引,分辨率变化时重建
+        lv_coord_t anim_attr_hor;  // 构建动画属性表时的水平分辨率
+        lv_coord_t anim_attr_ver;  // 构建动画属性表时的垂直分辨率
+        lv_task_t *preload_task;   // 预加载任务,没有等待加载的页面时删除
+        lv_task_t *load_task;      // 分帧构建任务,构建完成后删除
+        uint32_t preload_budget_us; // 预加载每帧的时间预算
+        lv_task_t *cache_task;      // 缓存超时检查任务,不按时间淘汰时删除
+        uint32_t cache_max_objs;    // 缓存预算(lvgl对象数量)
+        uint32_t cache_ttl;         // 缓存超时时间(ms)
+        pm_snapshot_cb_t snapshot_cb; // 页面快照回调,NULL时切换动画直接移动根对象
+#if PAGE_MANAGER_USE_STATS
+        uint32_t stats_input_tick;  // 最近一次切换请求的时间
+#endif
+        pm_allocator_t allocator;   // 内存分配器
+        pm_alloc_stat_t alloc_stat; // 内存统计
+        bool alloc_locked;          // 内存申请锁定标志位
     } page_manager_t;
 
     /**
@@ -100,6 +230,37 @@ extern "C"
      */
     page_manager_t *page_manager_create(void);
 
+    /**
+     * @brief 使用指定的内存分配器创建页面管理器对象
+     *  @note 页面管理器自身、页面表和页面数据块都从该分配器申请
+     *
+     * @param allocator 内存分配器,内容会被复制
+     * @return page_manager_t* 页面管理器对象
+     */
+    page_manager_t *page_manager_create_with_allocator(const pm_allocator_t *allocator);
+
+    /**
+     * @brief 创建绑定到指定显示器或容器的页面管理器对象
+     *  @note 页面根对象创建在parent中,尺寸和切换动画的距离取parent的大小;
+     *        parent为NULL时使用disp的活动屏幕和分辨率,多个显示器上的页面管理器互不影响
+     *
+     * @param disp 显示器,NULL时使用默认显示器
+     * @param parent 页面根对象的父对象,NULL时使用disp的活动屏幕
+     * @return page_manager_t* 页面管理器对象
+     */
+    page_manager_t *page_manager_create_for(lv_disp_t *disp, lv_obj_t *parent);
+
+    /**
+     * @brief 使用指定的内存分配器创建绑定到指定显示器或容器的页面管理器对象
+     *  @note 每个显示器的页面管理器可以使用各自的内存区
+     *
+     * @param disp 显示器,NULL时使用默认显示器
+     * @param parent 页面根对象的父对象,NULL时使用disp的活动屏幕
+     * @param allocator 内存分配器,内容会被复制
+     * @return page_manager_t* 页面管理器对象
+     */
+    page_manager_t *page_manager_create_for_with_allocator(lv_disp_t *disp, lv_obj_t *parent, const pm_allocator_t *allocator);
+
     /**
      * @brief 删除页面管理器对象
      *
@@ -111,18 +272,39 @@ extern "C"
      * @brief 安装页面到页面管理器中
      *
      * @param self 页面管理器对象
+     * @param name 页面名称,需在页面卸载前保持有效
      * @param page_param 页面调度函数
+     * @return pm_page_id_t 页面句柄,失败返回PM_PAGE_ID_INVALID
      */
-    void pm_install(page_manager_t *self, const char *name, page_vtable_t* page_param);
+    pm_page_id_t pm_install(page_manager_t *self, const char *name, page_vtable_t* page_param);
 
     /**
      * @brief 页面管理器中卸载页面
+     *  @note 页面栈中的页面和退出动画正在播放的页面不能卸载
      *
      * @param self 页面管理器对象
      * @param name 页面名称
      */
     void pm_uninstall(page_manager_t *self, const char *name);
 
+    /**
+     * @brief 通过页面句柄卸载页面
+     *  @note 页面栈中的页面和退出动画正在播放的页面不能卸载
+     *
+     * @param self 页面管理器对象
+     * @param id 页面句柄
+     */
+    void pm_uninstall_id(page_manager_t *self, pm_page_id_t id);
+
+    /**
+     * @brief 通过页面名称获取页面句柄
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @return pm_page_id_t 页面句柄,未安装返回PM_PAGE_ID_INVALID
+     */
+    pm_page_id_t pm_get_page_id(page_manager_t *self, const char *name);
+
     /**
      * @brief 页面管理器中加载页面展示
      *
@@ -132,6 +314,81 @@ extern "C"
      */
     void pm_push(page_manager_t *self, const char *name, const page_stash_t *stash);
 
+    /**
+     * @brief 通过页面句柄加载页面展示
+     *
+     * @param self 页面管理器对象
+     * @param id 页面句柄
+     * @param stash 缓存区,没有数据就填NULL
+     */
+    void pm_push_id(page_manager_t *self, pm_page_id_t id, const page_stash_t *stash);
+
+    /**
+     * @brief 推送页面并把数据块的所有权转交给页面管理器,不复制数据
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @param ptr 数据块地址
+     * @param size 数据块大小
+     * @param free_cb 页面不再需要数据块时调用,可为NULL
+     * @return true 推送成功,数据块归页面管理器所有
+     * @return false 推送失败,数据块仍归调用者所有
+     */
+    bool pm_push_move(page_manager_t *self, const char *name, void *ptr, uint32_t size, page_stash_free_cb_t free_cb);
+
+    /**
+     * @brief 推送页面并引用共享数据块,多个页面可以同时引用同一数据块
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @param buf 共享数据块
+     * @return true 推送成功,页面持有一次引用
+     * @return false 推送失败
+     */
+    bool pm_push_shared(page_manager_t *self, const char *name, pm_shared_buf_t *buf);
+
+    /**
+     * @brief 创建共享数据块,引用计数为1,从页面管理器的分配器申请
+     *
+     * @param self 页面管理器对象
+     * @param size 数据大小
+     * @return pm_shared_buf_t* 共享数据块,失败返回NULL
+     */
+    pm_shared_buf_t *pm_shared_buf_create(page_manager_t *self, uint32_t size);
+
+    /**
+     * @brief 获取共享数据块的数据地址
+     *
+     * @param buf 共享数据块
+     * @return void* 数据地址
+     */
+    void *pm_shared_buf_data(pm_shared_buf_t *buf);
+
+    /**
+     * @brief 增加共享数据块的引用
+     *
+     * @param buf 共享数据块
+     */
+    void pm_shared_buf_retain(pm_shared_buf_t *buf);
+
+    /**
+     * @brief 减少共享数据块的引用,引用归零时释放
+     *
+     * @param buf 共享数据块
+     */
+    void pm_shared_buf_release(pm_shared_buf_t *buf);
+
+    /**
+     * @brief 用页面替换栈顶页面,栈顶页面出栈并播放push动画
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @param stash push时用户的自定义参数
+     * @return true 替换成功或已放入导航队列
+     * @return false 替换失败
+     */
+    bool pm_replace(page_manager_t *self, const char *name, const page_stash_t *stash);
+
     /**
      * @brief 回退到上一个页面
      *
@@ -139,12 +396,42 @@ extern "C"
      */
     void pm_pop(page_manager_t *self);
 
+    /**
+     * @brief 一次回退多层页面,只播放一次从栈顶到目标页面的切换动画,中间页面直接卸载
+     *
+     * @param self 页面管理器对象
+     * @param n 回退的层数,超过栈深度时回退到栈底页面
+     * @return true 回退成功或已放入导航队列
+     * @return false 导航队列已满或没有可回退的页面
+     */
+    bool pm_pop_n(page_manager_t *self, uint16_t n);
+
+    /**
+     * @brief 回退到页面栈中的指定页面,只播放一次切换动画
+     *
+     * @param self 页面管理器对象
+     * @param name 目标页面名称
+     * @return true 回退成功或已放入导航队列
+     * @return false 导航队列已满或目标页面不在页面栈中
+     */
+    bool pm_pop_to(page_manager_t *self, const char *name);
+
+    /**
+     * @brief 通过页面句柄回退到页面栈中的指定页面
+     *
+     * @param self 页面管理器对象
+     * @param id 目标页面句柄
+     * @return true 回退成功或已放入导航队列
+     * @return false 导航队列已满或目标页面不在页面栈中
+     */
+    bool pm_pop_to_id(page_manager_t *self, pm_page_id_t id);
+
     /**
      * @brief 返回主界面
      *
      * @param self 页面管理器对象
-     * @return true 返回成功
-     * @return false 页面正在切换
+     * @return true 返回成功或已放入导航队列
+     * @return false 导航队列已满
      */
     bool pm_back_home(page_manager_t *self);
 
@@ -156,7 +443,173 @@ extern "C"
      * @param time 动画持续时间
      * @param path 动画路径
      */
-    void pm_set_global_load_anim_type(page_manager_t *self, page_load_anim_t anim, uint16_t time, lv_anim_path_cb_t path);
+    void pm_set_global_load_anim_type(page_manager_t *self, uint8_t anim, uint16_t time, lv_anim_path_cb_t path);
+
+    /**
+     * @brief 注册切换动画类型
+     *  @note 返回的动画类型可用于pm_set_global_load_anim_type()和page_set_custom_load_anim_type(),
+     *        描述在页面管理器删除前必须保持有效
+     *
+     * @param self 页面管理器对象
+     * @param type 动画类型描述,setter和getter不能为NULL
+     * @return uint8_t 动画类型,描述无效或注册表已满时返回LOAD_ANIM_GLOBAL
+     */
+    uint8_t pm_register_anim_type(page_manager_t *self, const pm_anim_type_t *type);
+
+    /**
+     * @brief 在空闲帧中预加载页面,执行on_view_load和on_view_did_load
+     *  @note 根对象保持隐藏,之后push该页面时跳过加载直接显示
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @return true 已加入预加载或已经加载
+     * @return false 页面未安装或正在显示
+     */
+    bool pm_preload(page_manager_t *self, const char *name);
+
+    /**
+     * @brief 取消预加载,已经加载完成的页面会被卸载
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @return true 取消成功
+     * @return false 页面没有预加载或已经被push
+     */
+    bool pm_preload_cancel(page_manager_t *self, const char *name);
+
+    /**
+     * @brief 设置预加载每帧的时间预算
+     *
+     * @param self 页面管理器对象
+     * @param budget_us 时间预算(us),每帧至少加载一个页面
+     */
+    void pm_set_preload_budget(page_manager_t *self, uint32_t budget_us);
+
+    /**
+     * @brief 设置缓存预算
+     *  @note 隐藏的缓存页面持有的lvgl对象总数超出预算时,按优先级从低到高、
+     *        隐藏时间从早到晚淘汰;页面栈中的页面淘汰前调用on_save_state,
+     *        pop时重新加载后调用on_restore_state
+     *
+     * @param self 页面管理器对象
+     * @param max_objs lvgl对象数量,0 不限制
+     */
+    void pm_set_cache_budget(page_manager_t *self, uint32_t max_objs);
+
+    /**
+     * @brief 设置缓存超时时间,隐藏超过该时间的缓存页面被淘汰
+     *
+     * @param self 页面管理器对象
+     * @param ttl_ms 超时时间(ms),0 不按时间淘汰
+     */
+    void pm_set_cache_ttl(page_manager_t *self, uint32_t ttl_ms);
+
+    /**
+     * @brief 设置切换动画播放期间收到新的导航请求时的处理方式
+     *  @note 优先级大于0的页面push时,PM_PREEMPT_NONE按PM_PREEMPT_FINISH处理
+     *
+     * @param self 页面管理器对象
+     * @param preempt 处理方式
+     */
+    void pm_set_preempt_mode(page_manager_t *self, pm_preempt_t preempt);
+
+    /**
+     * @brief 设置页面快照回调,平移/覆盖类切换动画移动快照而不是整棵控件树
+     *  @note 切换动画开始时为进入和退出的页面各调用一次,根对象在动画期间隐藏,
+     *        动画结束或被打断时根对象移动到快照的位置后显示,快照被删除;
+     *        快照占用的缓冲区请在快照对象的LV_EVENT_DELETE事件中释放
+     *
+     * @param self 页面管理器对象
+     * @param snapshot_cb 快照回调,NULL 关闭
+     */
+    void pm_set_snapshot_cb(page_manager_t *self, pm_snapshot_cb_t snapshot_cb);
+
+    /**
+     * @brief 获取页面管理器的内存统计
+     *
+     * @param self 页面管理器对象
+     * @param stat [out]内存统计
+     */
+    void pm_get_alloc_stat(page_manager_t *self, pm_alloc_stat_t *stat);
+
+    /**
+     * @brief 锁定页面管理器的内存申请,预热完成后开启,锁定期间的申请会被记录
+     *
+     * @param self 页面管理器对象
+     * @param en 是否锁定
+     */
+    void pm_set_alloc_locked(page_manager_t *self, bool en);
+
+    /**
+     * @brief 获取页面管理器的运行状况
+     *
+     * @param self 页面管理器对象
+     * @param health [out]运行状况
+     */
+    void pm_get_health(page_manager_t *self, pm_health_t *health);
+
+    /**
+     * @brief 设置统计/trace/延迟日志使用的微秒时钟
+     *  @note 基准测试中可以传入可控的时钟,使耗时与lvgl的tick无关
+     *
+     * @param clock_cb 时钟回调,返回微秒,NULL时恢复为lv_tick_get()换算
+     */
+    void pm_set_clock(pm_clock_cb_t clock_cb);
+
+    /**
+     * @brief 获取当前时钟
+     *
+     * @return uint32_t 微秒
+     */
+    uint32_t pm_clock_us(void);
+
+    /**
+     * @brief 获取页面的生命周期耗时统计,需要开启PAGE_MANAGER_USE_STATS
+     *
+     * @param self 页面管理器对象
+     * @param name 页面名称
+     * @param stats [out]耗时统计
+     * @return true 获取成功
+     * @return false 页面未安装或统计未开启
+     */
+    bool pm_get_page_stats(page_manager_t *self, const char *name, pm_page_stats_t *stats);
+
+    /**
+     * @brief 清空所有页面的耗时统计
+     *
+     * @param self 页面管理器对象
+     */
+    void pm_reset_stats(page_manager_t *self);
+
+    /**
+     * @brief 打印所有页面的耗时统计
+     *
+     * @param self 页面管理器对象
+     */
+    void pm_dump_stats(page_manager_t *self);
+
+    /**
+     * @brief 以JSON格式输出所有页面的耗时统计,用于基准测试和回归比较
+     *
+     * @param self 页面管理器对象
+     * @param fp 输出文件
+     */
+    void pm_dump_stats_json(page_manager_t *self, FILE *fp);
+
+    /**
+     * @brief 开始记录导航trace,需要开启PAGE_MANAGER_USE_TRACE
+     *  @note 文件为Chrome/Perfetto JSON格式,可在chrome://tracing或ui.perfetto.dev中打开
+     *
+     * @param path 文件路径
+     * @return true 开始成功
+     * @return false 文件打开失败或trace未开启
+     */
+    bool pm_trace_start(const char *path);
+
+    /**
+     * @brief 停止记录导航trace并关闭文件
+     */
+    void pm_trace_stop(void);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -2,19 +2,131 @@
 
 #include "page_manager.h"
 
+/* 页面句柄编码 */
+#define PM_PAGE_ID_INDEX(id) ((uint16_t)((id) & 0xFFFF))
+#define PM_PAGE_ID_MAKE(gen, index) (((pm_page_id_t)(gen) << 16) | (pm_page_id_t)(index))
+
+/* 页面热数据访问 */
+#define PAGE_HOT_STATE(base) ((base)->manager->page_hot.state[PM_PAGE_ID_INDEX((base)->id)])
+#define PAGE_HOT_IS_CACHED(base) ((base)->manager->page_hot.is_cached[PM_PAGE_ID_INDEX((base)->id)])
+#define PAGE_HOT_IS_BUSY(base) ((base)->manager->page_hot.is_busy[PM_PAGE_ID_INDEX((base)->id)])
+#define PAGE_HOT_IS_IN_STACK(base) ((base)->manager->page_hot.is_in_stack[PM_PAGE_ID_INDEX((base)->id)])
+
+/* page_mem */
+void *pm_mem_alloc(page_manager_t *self, uint32_t size);
+void pm_mem_free(page_manager_t *self, void *ptr, uint32_t size);
+
+/* page_stash */
+struct pm_shared_buf_t
+{
+    page_manager_t *manager;
+    uint32_t ref;
+    uint32_t size;
+    union
+    {
+        void *align_ptr;
+        double align_double;
+    } data[]; // 数据紧跟在头部之后
+};
+
+#define STASH_POOL_CLASS_SIZE(cls) ((uint32_t)PAGE_MANAGER_STASH_INLINE_SIZE << ((cls) + 1))
+bool stash_store(page_base_t *base, const page_stash_t *stash);
+void stash_release(page_base_t *base);
+void stash_move(page_base_t *base, void *ptr, uint32_t size, page_stash_free_cb_t free_cb);
+void stash_share(page_base_t *base, pm_shared_buf_t *buf);
+void stash_pool_clear(page_manager_t *self);
+uint32_t stash_pool_free_count(page_manager_t *self);
+
+/* page_stats */
+#if PAGE_MANAGER_USE_STATS
+void stats_record(page_base_t *base, pm_stat_metric_t metric, uint32_t us);
+
+static inline uint32_t stats_tick(void)
+{
+    return PM_TICK_US();
+}
+
+static inline void stats_input(page_manager_t *self, page_base_t *base)
+{
+    self->stats_input_tick = PM_TICK_US();
+    base->stats.is_cached = PAGE_HOT_IS_CACHED(base);
+}
+
+static inline void stats_appear_begin(page_base_t *base)
+{
+    base->stats.appear_tick = PM_TICK_US();
+}
+
+static inline void stats_since(page_base_t *base, pm_stat_metric_t metric, uint32_t *tick)
+{
+    uint32_t now = PM_TICK_US();
+    stats_record(base, metric, now - *tick);
+    *tick = now;
+}
+
+static inline void stats_first_frame(page_manager_t *self, page_base_t *base)
+{
+    if (base == self->page_current)
+    {
+        stats_record(base, PM_STAT_FIRST_FRAME, PM_TICK_US() - self->stats_input_tick);
+    }
+}
+
+static inline void stats_appear_end(page_manager_t *self, page_base_t *base)
+{
+    uint32_t now = PM_TICK_US();
+    stats_record(base, PM_STAT_TRANSITION, now - base->stats.appear_tick);
+    stats_record(base, base->stats.is_cached ? PM_STAT_APPEAR_CACHED : PM_STAT_APPEAR_UNCACHED, now - self->stats_input_tick);
+}
+#else
+static inline uint32_t stats_tick(void) { return 0; }
+static inline void stats_input(page_manager_t *self, page_base_t *base) { (void)self; (void)base; }
+static inline void stats_appear_begin(page_base_t *base) { (void)base; }
+static inline void stats_since(page_base_t *base, pm_stat_metric_t metric, uint32_t *tick) { (void)base; (void)metric; (void)tick; }
+static inline void stats_first_frame(page_manager_t *self, page_base_t *base) { (void)self; (void)base; }
+static inline void stats_appear_end(page_manager_t *self, page_base_t *base) { (void)self; (void)base; }
+#endif
+
+/* page_queue */
+bool nav_queue_post(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, uint16_t n);
+bool nav_queue_post_push(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, const pm_nav_stash_t *stash);
+void nav_queue_drain(page_manager_t *self);
+bool nav_queue_is_empty(page_manager_t *self);
+void nav_queue_clear(page_manager_t *self);
+
+/* page_trace */
+#if PAGE_MANAGER_USE_TRACE
+void trace_state(page_base_t *base, page_state_t state);
+void trace_anim_begin(page_base_t *base);
+void trace_anim_end(page_base_t *base);
+void trace_drag(page_base_t *base, lv_event_t event);
+#else
+static inline void trace_state(page_base_t *base, page_state_t state) { (void)base; (void)state; }
+static inline void trace_anim_begin(page_base_t *base) { (void)base; }
+static inline void trace_anim_end(page_base_t *base) { (void)base; }
+static inline void trace_drag(page_base_t *base, lv_event_t event) { (void)base; (void)event; }
+#endif
+
 /* page_base */
-page_base_t *page_base_create(void);
-void page_base_delete(void *self);
+page_base_t *page_base_create(page_manager_t *manager);
+void page_base_delete(page_base_t *self);
 page_base_t *find_page_pool(page_manager_t *self, const char *name);
-page_base_t *find_page_stack(page_manager_t *self, const char *name);
+page_base_t *find_page_id(page_manager_t *self, pm_page_id_t id);
+void stack_push(page_manager_t *self, page_base_t *base);
+page_base_t *stack_pop(page_manager_t *self);
 page_base_t *get_stack_top(page_manager_t *self);
 page_base_t *get_stack_top_after(page_manager_t *self);
-void set_satck_clear(page_manager_t *self, bool keep_bottom);
 const char *get_page_prev_name(page_manager_t *self);
+lv_obj_t *get_root_parent(page_manager_t *self);
+void get_resolution(page_manager_t *self, lv_coord_t *hor, lv_coord_t *ver);
 
 /* page_anim */
 page_load_anim_t page_get_current_load_anim_type(page_manager_t *self);
-bool page_get_current_load_anim_attr(page_manager_t *self, page_load_anim_attr_t *attr);
+const page_load_anim_attr_t *page_get_current_load_anim_attr(page_manager_t *self);
+void page_anim_attr_update(page_manager_t *self);
+void page_anim_register_builtin(page_manager_t *self);
+bool page_anim_type_is_valid(page_manager_t *self, uint8_t anim);
+void page_anim_release(page_base_t *base);
 
 /* page_drag */
 void page_root_drag_event(lv_obj_t *obj, lv_event_t event);
@@ -25,7 +137,29 @@ void root_get_drag_predict(lv_coord_t *x, lv_coord_t *y);
 bool fource_unload(page_base_t *base);
 void switch_anim_create(page_manager_t *self, page_base_t *base);
 void anim_default_init(page_manager_t *self, lv_anim_t *a);
+void page_reveal(page_base_t *base);
+void page_occlusion_update(page_manager_t *self);
 
 /* page_state */
 void page_state_update(page_manager_t *self, page_base_t *base);
-page_state_t state_unload_execute(page_base_t *base);
\ No newline at end of file
+page_state_t state_unload_execute(page_base_t *base);
+page_state_t state_preload_execute(page_base_t *base, uint32_t start);
+page_state_t state_evict_execute(page_base_t *base);
+void state_under_restore(page_manager_t *self);
+void state_load_task_delete(page_manager_t *self);
+
+/* page_preload */
+enum
+{
+    PAGE_PRELOAD_NONE,     // 没有预加载
+    PAGE_PRELOAD_PENDING,  // 等待空闲帧加载
+    PAGE_PRELOAD_BUILDING, // 根对象已创建并隐藏,on_view_load_step分帧构建中
+    PAGE_PRELOAD_DONE,     // 已加载,根对象隐藏,等待push
+};
+
+void preload_task_delete(page_manager_t *self);
+
+/* page_cache */
+bool cache_is_hidden(page_manager_t *self, page_base_t *base);
+uint16_t cache_trim(page_manager_t *self);
+void cache_task_delete(page_manager_t *self);
\ No newline at end of file
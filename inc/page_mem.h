@@ -0,0 +1,51 @@
+#pragma once
+
+#include "page_config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /* 页面管理器内存分配器 */
+    typedef struct
+    {
+        void *(*alloc)(void *ctx, size_t size);
+        void (*free)(void *ctx, void *ptr);
+        void *(*realloc)(void *ctx, void *ptr, size_t size);
+        void *ctx;
+    } pm_allocator_t;
+
+    /* 固定内存区上的内存池,从末尾线性申请;释放的块按地址排序放入空闲链表,相邻的块合并,
+       再次申请时首次适配,末尾的空闲块直接退回 */
+    typedef struct
+    {
+        uint8_t *buf;
+        size_t size;
+        size_t used;     // 已经线性申请过的字节数
+        void *free_list; // 空闲块链表,按地址从低到高排序
+    } pm_arena_t;
+
+    /* 默认分配器,使用page_config.h中的PM_MALLOC/PM_FREE/PM_REALLOC */
+    extern const pm_allocator_t pm_allocator_default;
+
+    /* 标准库分配器,malloc/free/realloc */
+    extern const pm_allocator_t pm_allocator_libc;
+
+    /* lvgl堆分配器,lv_mem_alloc/lv_mem_free/lv_mem_realloc */
+    extern const pm_allocator_t pm_allocator_lvgl;
+
+    /**
+     * @brief 在用户提供的内存区上初始化内存池,并生成对应的分配器
+     *  @note 内存池对象和内存区需要在页面管理器删除前保持有效
+     *
+     * @param arena 内存池对象
+     * @param buf 内存区
+     * @param size 内存区大小
+     * @param allocator [out]使用该内存池的分配器
+     */
+    void pm_arena_init(pm_arena_t *arena, void *buf, size_t size, pm_allocator_t *allocator);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -1,181 +1,118 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_ANIM
+
 #include "page_manager_private.h"
 
-static bool _get_load_anim_attr(uint8_t anim, page_load_anim_attr_t *attr);
 static void _lv_anim_setter_x(void *obj, int16_t v);
 static int32_t _lv_anim_getter_x(void *obj);
 static void _lv_anim_setter_y(void *obj, int16_t v);
 static int32_t _lv_anim_getter_y(void *obj);
 static void _lv_anim_setter_opa(void *obj, int16_t v);
 static int32_t _lv_anim_getter_opa(void *obj);
+static bool _lv_anim_release_opa(lv_obj_t *obj);
+
+/* 平移类动画的起止值,单位为显示区域宽度或高度的千分比 */
+#define PM_ANIM_FULL 1000
+#define PM_ANIM_VALUE(enter_start, enter_end, exit_start, exit_end) \
+    {{(enter_start), (enter_end)}, {(exit_start), (exit_end)}}
+
+/* 内置的动画类型,按page_load_anim_t索引 */
+static const pm_anim_type_t _anim_builtin[_LOAD_ANIM_LAST + 1] = {
+    [LOAD_ANIM_OVER_LEFT] = {
+        _lv_anim_setter_x, _lv_anim_getter_x, ROOT_DRAG_DIR_HOR, PM_ANIM_UNIT_HOR,
+        PM_ANIM_VALUE(PM_ANIM_FULL, 0, 0, 0),
+        PM_ANIM_VALUE(0, 0, 0, PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_OVER_RIGHT] = {
+        _lv_anim_setter_x, _lv_anim_getter_x, ROOT_DRAG_DIR_HOR, PM_ANIM_UNIT_HOR,
+        PM_ANIM_VALUE(-PM_ANIM_FULL, 0, 0, 0),
+        PM_ANIM_VALUE(0, 0, 0, -PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_OVER_TOP] = {
+        _lv_anim_setter_y, _lv_anim_getter_y, ROOT_DRAG_DIR_VER, PM_ANIM_UNIT_VER,
+        PM_ANIM_VALUE(PM_ANIM_FULL, 0, 0, 0),
+        PM_ANIM_VALUE(0, 0, 0, PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_OVER_BOTTOM] = {
+        _lv_anim_setter_y, _lv_anim_getter_y, ROOT_DRAG_DIR_VER, PM_ANIM_UNIT_VER,
+        PM_ANIM_VALUE(-PM_ANIM_FULL, 0, 0, 0),
+        PM_ANIM_VALUE(0, 0, 0, -PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_MOVE_LEFT] = {
+        _lv_anim_setter_x, _lv_anim_getter_x, ROOT_DRAG_DIR_HOR, PM_ANIM_UNIT_HOR,
+        PM_ANIM_VALUE(PM_ANIM_FULL, 0, 0, -PM_ANIM_FULL),
+        PM_ANIM_VALUE(-PM_ANIM_FULL, 0, 0, PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_MOVE_RIGHT] = {
+        _lv_anim_setter_x, _lv_anim_getter_x, ROOT_DRAG_DIR_HOR, PM_ANIM_UNIT_HOR,
+        PM_ANIM_VALUE(-PM_ANIM_FULL, 0, 0, PM_ANIM_FULL),
+        PM_ANIM_VALUE(PM_ANIM_FULL, 0, 0, -PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_MOVE_TOP] = {
+        _lv_anim_setter_y, _lv_anim_getter_y, ROOT_DRAG_DIR_VER, PM_ANIM_UNIT_VER,
+        PM_ANIM_VALUE(PM_ANIM_FULL, 0, 0, -PM_ANIM_FULL),
+        PM_ANIM_VALUE(-PM_ANIM_FULL, 0, 0, PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_MOVE_BOTTOM] = {
+        _lv_anim_setter_y, _lv_anim_getter_y, ROOT_DRAG_DIR_VER, PM_ANIM_UNIT_VER,
+        PM_ANIM_VALUE(-PM_ANIM_FULL, 0, 0, PM_ANIM_FULL),
+        PM_ANIM_VALUE(PM_ANIM_FULL, 0, 0, -PM_ANIM_FULL),
+        NULL, false},
+    [LOAD_ANIM_FADE_ON] = {
+        _lv_anim_setter_opa, _lv_anim_getter_opa, ROOT_DRAG_DIR_NONE, PM_ANIM_UNIT_VALUE,
+        PM_ANIM_VALUE(LV_OPA_TRANSP, LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER),
+        PM_ANIM_VALUE(LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER, LV_OPA_TRANSP),
+        _lv_anim_release_opa, false},
+    /* 没有动画,所有数值为0 */
+    [LOAD_ANIM_NONE] = {0},
+};
 
 /**
- * @brief 获取加载动画的参数
+ * @brief 按数值单位换算动画数值
  *
- * @param anim 动画路径
- * @param attr [out]动画属性
- * @return true 获取成功
- * @return false 获取失败
+ * @param value 动画数值
+ * @param unit 数值单位
+ * @param hor 显示区域宽度
+ * @param ver 显示区域高度
+ * @return int32_t 换算后的数值
  */
-static bool _get_load_anim_attr(uint8_t anim, page_load_anim_attr_t *attr)
+static int32_t _anim_value_scale(int32_t value, uint8_t unit, lv_coord_t hor, lv_coord_t ver)
 {
-    lv_coord_t hor = LV_HOR_RES;
-    lv_coord_t ver = LV_VER_RES;
-
-    switch (anim)
+    switch (unit)
     {
-    case LOAD_ANIM_OVER_LEFT:
-        attr->drag_dir = ROOT_DRAG_DIR_HOR;
-
-        attr->push.enter.start = hor;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = 0;
-
-        attr->pop.enter.start = 0;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = hor;
-        break;
-
-    case LOAD_ANIM_OVER_RIGHT:
-        attr->drag_dir = ROOT_DRAG_DIR_HOR;
-
-        attr->push.enter.start = -hor;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = 0;
-
-        attr->pop.enter.start = 0;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = -hor;
-        break;
-
-    case LOAD_ANIM_OVER_TOP:
-        attr->drag_dir = ROOT_DRAG_DIR_VER;
-
-        attr->push.enter.start = ver;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = 0;
-
-        attr->pop.enter.start = 0;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = ver;
-        break;
-
-    case LOAD_ANIM_OVER_BOTTOM:
-        attr->drag_dir = ROOT_DRAG_DIR_VER;
-
-        attr->push.enter.start = -ver;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = 0;
-
-        attr->pop.enter.start = 0;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = -ver;
-        break;
-
-    case LOAD_ANIM_MOVE_LEFT:
-        attr->drag_dir = ROOT_DRAG_DIR_HOR;
-
-        attr->push.enter.start = hor;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = -hor;
-
-        attr->pop.enter.start = -hor;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = hor;
-        break;
-
-    case LOAD_ANIM_MOVE_RIGHT:
-        attr->drag_dir = ROOT_DRAG_DIR_HOR;
-
-        attr->push.enter.start = -hor;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = hor;
-
-        attr->pop.enter.start = hor;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = -hor;
-        break;
-
-    case LOAD_ANIM_MOVE_TOP:
-        attr->drag_dir = ROOT_DRAG_DIR_VER;
-
-        attr->push.enter.start = ver;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = -ver;
-
-        attr->pop.enter.start = -ver;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = ver;
-        break;
-
-    case LOAD_ANIM_MOVE_BOTTOM:
-        attr->drag_dir = ROOT_DRAG_DIR_VER;
-
-        attr->push.enter.start = -ver;
-        attr->push.enter.end = 0;
-        attr->push.exit.start = 0;
-        attr->push.exit.end = ver;
-
-        attr->pop.enter.start = ver;
-        attr->pop.enter.end = 0;
-        attr->pop.exit.start = 0;
-        attr->pop.exit.end = -ver;
-        break;
-
-    case LOAD_ANIM_FADE_ON:
-        attr->drag_dir = ROOT_DRAG_DIR_NONE;
-
-        attr->push.enter.start = LV_OPA_TRANSP;
-        attr->push.enter.end = LV_OPA_COVER;
-        attr->push.exit.start = LV_OPA_COVER;
-        attr->push.exit.end = LV_OPA_COVER;
-
-        attr->pop.enter.start = LV_OPA_COVER;
-        attr->pop.enter.end = LV_OPA_COVER;
-        attr->pop.exit.start = LV_OPA_COVER;
-        attr->pop.exit.end = LV_OPA_TRANSP;
-        break;
-
-    case LOAD_ANIM_NONE:
-        memset(attr, 0, sizeof(page_load_anim_attr_t));
-        return true;
-
+    case PM_ANIM_UNIT_HOR:
+        return value * hor / PM_ANIM_FULL;
+    case PM_ANIM_UNIT_VER:
+        return value * ver / PM_ANIM_FULL;
     default:
-        PM_LOG_ERROR("Load anim type error: %d", anim);
-        return false;
+        return value;
     }
+}
 
-    /* 确定动画的setter和getter*/
-    if (attr->drag_dir == ROOT_DRAG_DIR_HOR)
-    {
-        attr->setter = _lv_anim_setter_x;
-        attr->getter = _lv_anim_getter_x;
-    }
-    else if (attr->drag_dir == ROOT_DRAG_DIR_VER)
-    {
-        attr->setter = _lv_anim_setter_y;
-        attr->getter = _lv_anim_getter_y;
-    }
-    else
+/**
+ * @brief 按显示区域大小计算动画类型的属性
+ *
+ * @param type 动画类型描述
+ * @param hor 显示区域宽度
+ * @param ver 显示区域高度
+ * @param attr [out]动画属性
+ */
+static void _anim_attr_build(const pm_anim_type_t *type, lv_coord_t hor, lv_coord_t ver, page_load_anim_attr_t *attr)
+{
+    const page_anim_value_t *src[2] = {&type->push, &type->pop};
+    page_anim_value_t *dst[2] = {&attr->push, &attr->pop};
+
+    attr->setter = type->setter;
+    attr->getter = type->getter;
+    attr->drag_dir = type->drag_dir;
+    attr->release = type->release;
+    attr->is_partial = type->is_partial;
+    for (int i = 0; i < 2; i++)
     {
-        attr->setter = _lv_anim_setter_opa;
-        attr->getter = _lv_anim_getter_opa;
+        dst[i]->enter.start = _anim_value_scale(src[i]->enter.start, type->unit, hor, ver);
+        dst[i]->enter.end = _anim_value_scale(src[i]->enter.end, type->unit, hor, ver);
+        dst[i]->exit.start = _anim_value_scale(src[i]->exit.start, type->unit, hor, ver);
+        dst[i]->exit.end = _anim_value_scale(src[i]->exit.end, type->unit, hor, ver);
     }
-
-    return true;
 }
 
 /**
@@ -223,25 +160,65 @@ static int32_t _lv_anim_getter_y(void *obj)
 };
 
 /**
- * @brief 设置透明度的数值
+ * @brief 设置整个页面的透明度
+ *  @note opa_scale会被子对象继承,整个页面一起淡入淡出;数值不变时不写样式,避免无效的样式刷新和重绘
  *
  * @param obj lvgl屏幕对象
  * @param v 滑动数值
  */
 static void _lv_anim_setter_opa(void *obj, int16_t v)
 {
-    lv_obj_set_style_local_bg_opa((lv_obj_t *)obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (lv_opa_t)v);
+    if (lv_obj_get_style_opa_scale((lv_obj_t *)obj, LV_OBJ_PART_MAIN) == (lv_opa_t)v)
+    {
+        return;
+    }
+    lv_obj_set_style_local_opa_scale((lv_obj_t *)obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (lv_opa_t)v);
 }
 
 /**
- * @brief 获取透明度的数值
+ * @brief 获取整个页面的透明度
  *
  * @param obj lvgl屏幕对象
  * @param v 滑动数值
  */
 static int32_t _lv_anim_getter_opa(void *obj)
 {
-    return (int32_t)lv_obj_get_style_bg_opa((lv_obj_t *)obj, LV_OBJ_PART_MAIN);
+    return (int32_t)lv_obj_get_style_opa_scale((lv_obj_t *)obj, LV_OBJ_PART_MAIN);
+}
+
+/**
+ * @brief 删除淡入淡出使用的本地样式
+ *
+ * @param obj lvgl屏幕对象
+ * @return true 页面完全透明
+ * @return false 页面可见
+ */
+static bool _lv_anim_release_opa(lv_obj_t *obj)
+{
+    lv_opa_t opa = lv_obj_get_style_opa_scale(obj, LV_OBJ_PART_MAIN);
+    lv_obj_remove_style_local_prop(obj, LV_OBJ_PART_MAIN, LV_STYLE_OPA_SCALE);
+    return opa == LV_OPA_TRANSP;
+}
+
+/**
+ * @brief 切换动画结束后释放动画留下的样式
+ *  @note 动画结束后不可见的页面改为隐藏,下一次切换时再显示
+ *
+ * @param base 页面对象
+ */
+void page_anim_release(page_base_t *base)
+{
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(base->manager);
+    if (anim_attr == NULL || anim_attr->release == NULL || base->root == NULL)
+    {
+        return;
+    }
+
+    if (anim_attr->release(base->root))
+    {
+        base->priv.is_occluded = true;
+        lv_obj_set_hidden(base->root, true);
+    }
 }
 
 /**
@@ -259,11 +236,100 @@ page_load_anim_t page_get_current_load_anim_type(page_manager_t *self)
  * @brief 获取当前页面动画参数
  *
  * @param self 页面管理器对象
- * @param attr [out]页面动画参数
- * @return true 获取成功
- * @return false 获取失败
+ * @return const page_load_anim_attr_t* 页面动画参数,动画类型未注册时返回NULL
+ */
+const page_load_anim_attr_t *page_get_current_load_anim_attr(page_manager_t *self)
+{
+    uint8_t anim = page_get_current_load_anim_type(self);
+    if (!page_anim_type_is_valid(self, anim))
+    {
+        PM_LOG_ERROR("Load anim type error: %d", anim);
+        return NULL;
+    }
+    return &self->anim_attr_table[anim];
+}
+
+/**
+ * @brief 显示区域大小(分辨率、旋转或容器大小)变化时重建所有动画类型的属性表
+ *  @note 在页面切换和拖拽开始时调用,动画播放和拖拽过程中直接查表
+ *
+ * @param self 页面管理器对象
+ */
+void page_anim_attr_update(page_manager_t *self)
+{
+    lv_coord_t hor;
+    lv_coord_t ver;
+    get_resolution(self, &hor, &ver);
+
+    if (hor == self->anim_attr_hor && ver == self->anim_attr_ver)
+    {
+        return;
+    }
+
+    PM_LOG_INFO("Anim attr table rebuild, resolution = %dx%d", hor, ver);
+    for (uint8_t anim = 0; anim < PAGE_MANAGER_ANIM_TYPE_MAX; anim++)
+    {
+        if (self->anim_types[anim] != NULL)
+        {
+            _anim_attr_build(self->anim_types[anim], hor, ver, &self->anim_attr_table[anim]);
+        }
+    }
+    self->anim_attr_hor = hor;
+    self->anim_attr_ver = ver;
+}
+
+/**
+ * @brief 将内置的动画类型注册到页面管理器
+ *
+ * @param self 页面管理器对象
+ */
+void page_anim_register_builtin(page_manager_t *self)
+{
+    for (uint8_t anim = LOAD_ANIM_OVER_LEFT; anim <= _LOAD_ANIM_LAST; anim++)
+    {
+        self->anim_types[anim] = &_anim_builtin[anim];
+    }
+}
+
+/**
+ * @brief 检测动画类型是否已注册
+ *
+ * @param self 页面管理器对象
+ * @param anim 动画类型
+ * @return true 已注册
+ * @return false LOAD_ANIM_GLOBAL或未注册
  */
-bool page_get_current_load_anim_attr(page_manager_t *self, page_load_anim_attr_t *attr)
+bool page_anim_type_is_valid(page_manager_t *self, uint8_t anim)
 {
-    return _get_load_anim_attr(page_get_current_load_anim_type(self), attr);
+    return anim != LOAD_ANIM_GLOBAL && anim < PAGE_MANAGER_ANIM_TYPE_MAX && self->anim_types[anim] != NULL;
+}
+
+/**
+ * @brief 注册切换动画类型
+ *
+ * @param self 页面管理器对象
+ * @param type 动画类型描述,setter和getter不能为NULL
+ * @return uint8_t 动画类型,描述无效或注册表已满时返回LOAD_ANIM_GLOBAL
+ */
+uint8_t pm_register_anim_type(page_manager_t *self, const pm_anim_type_t *type)
+{
+    if (type == NULL || type->setter == NULL || type->getter == NULL)
+    {
+        PM_LOG_ERROR("Anim type must have a setter and a getter");
+        return LOAD_ANIM_GLOBAL;
+    }
+
+    for (uint8_t anim = _LOAD_ANIM_LAST + 1; anim < PAGE_MANAGER_ANIM_TYPE_MAX; anim++)
+    {
+        if (self->anim_types[anim] == NULL)
+        {
+            self->anim_types[anim] = type;
+            _anim_attr_build(type, self->anim_attr_hor, self->anim_attr_ver, &self->anim_attr_table[anim]);
+            PM_LOG_INFO("Anim type[%d] registered", anim);
+            return anim;
+        }
+    }
+
+    PM_LOG_ERROR("Anim type registry is full");
+    return LOAD_ANIM_GLOBAL;
 }
@@ -1,34 +1,54 @@
-#include "page_base.h"
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_BASE
+
+#include "page_manager_private.h"
 
 /**
- * @brief 创建基础页面
+ * @brief 在页面表中分配页面对象
  *
- * @return page_base_t* 返回页面对象
+ * @param manager 页面管理器对象
+ * @return page_base_t* 返回页面对象,页面表已满时返回NULL
  */
-page_base_t *page_base_create(void)
+page_base_t *page_base_create(page_manager_t *manager)
 {
-    page_base_t *page_base = (page_base_t *)PM_MALLOC(sizeof(page_base_t));
-    if (page_base == NULL)
+    uint16_t index = 0;
+    while (index < PAGE_MANAGER_PAGE_MAX && manager->page_table[index].manager != NULL)
+    {
+        index++;
+    }
+    if (index == PAGE_MANAGER_PAGE_MAX)
     {
-        PM_LOG_ERROR("page_base alloc error\n");
+        PM_LOG_ERROR("page_base alloc error, page table is full\n");
         return NULL;
     }
+
+    page_base_t *page_base = &manager->page_table[index];
+    memset(page_base, 0, sizeof(page_base_t));
+    page_base->id = PM_PAGE_ID_MAKE(manager->page_generation[index], index);
+    page_base->manager = manager;
+
+    manager->page_hot.state[index] = PAGE_STATE_IDLE;
+    manager->page_hot.is_cached[index] = false;
+    manager->page_hot.is_busy[index] = false;
+    manager->page_hot.is_in_stack[index] = false;
     return page_base;
 }
 
 /**
- * @brief 删除页面对象
+ * @brief 删除页面对象,归还页面表中的位置
+ *  @note 槽位的代数加1,指向该页面的旧句柄随之失效
  *
  * @param self 页面对象
  */
-void page_base_delete(void *self)
+void page_base_delete(page_base_t *self)
 {
     if (self == NULL)
     {
         PM_LOG_ERROR("page_base is NULL\n");
         return;
     }
-    PM_FREE(self);
+    stash_release(self);
+    self->manager->page_generation[PM_PAGE_ID_INDEX(self->id)]++;
+    memset(self, 0, sizeof(page_base_t));
 }
 
 /**
@@ -80,6 +100,39 @@ void page_set_custom_root_event_cb(page_base_t *self, lv_event_cb_t root_event_c
     self->root_event_cb = root_event_cb;
 }
 
+/**
+ * @brief 设置页面优先级
+ *
+ * @param self 页面对象
+ * @param priority 优先级
+ */
+void page_set_custom_priority(page_base_t *self, uint8_t priority)
+{
+    self->priv.priority = priority;
+}
+
+/**
+ * @brief 固定页面缓存
+ *
+ * @param self 页面对象
+ * @param en 是否固定
+ */
+void page_set_custom_cache_pin(page_base_t *self, bool en)
+{
+    self->priv.is_pinned = en;
+}
+
+/**
+ * @brief 声明页面不透明
+ *
+ * @param self 页面对象
+ * @param en 是否不透明
+ */
+void page_set_custom_opaque(page_base_t *self, bool en)
+{
+    self->priv.is_opaque = en;
+}
+
 /**
  * @brief 获取缓存区里的数据
  *
@@ -98,4 +151,20 @@ bool page_get_stash(page_base_t *self, void *ptr, uint32_t size)
         retval = true;
     }
     return retval;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 借用缓存区里的数据,不复制
+ *
+ * @param self 页面对象
+ * @param size [out]数据长度,可为NULL
+ * @return const void* 数据地址,没有数据时返回NULL
+ */
+const void *page_borrow_stash(page_base_t *self, uint32_t *size)
+{
+    if (size != NULL)
+    {
+        *size = self->priv.stash.size;
+    }
+    return self->priv.stash.ptr;
+}
@@ -0,0 +1,148 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_CACHE
+
+#include "page_manager_private.h"
+
+/**
+ * @brief 缓存超时检查任务,切换动画和拖拽期间不执行
+ *
+ * @param task lvgl任务
+ */
+static void _cache_task_cb(lv_task_t *task)
+{
+    cache_trim((page_manager_t *)task->user_data);
+}
+
+/**
+ * @brief 检测页面是否为隐藏的缓存页面
+ *  @note 预加载的页面等待push,不计入缓存
+ *
+ * @param self 页面管理器对象
+ * @param base 页面对象
+ * @return true 页面已缓存且隐藏
+ * @return false 页面未加载或正在显示
+ */
+bool cache_is_hidden(page_manager_t *self, page_base_t *base)
+{
+    return base->manager != NULL && base->root != NULL && PAGE_HOT_IS_CACHED(base) &&
+           PAGE_HOT_STATE(base) == PAGE_STATE_WILL_APPEAR && base->priv.preload == PAGE_PRELOAD_NONE &&
+           base != self->page_current && base != self->page_prev;
+}
+
+/**
+ * @brief 按缓存预算和超时时间淘汰页面栈中隐藏的缓存页面
+ *  @note 超时的页面直接淘汰;超出预算时按优先级从低到高、隐藏时间从早到晚淘汰,
+ *        固定的页面和栈顶下方的页面(拖拽返回时可见)不淘汰;
+ *        出栈时自动缓存的页面已取消缓存,只遍历页面栈
+ *
+ * @param self 页面管理器对象
+ * @return uint16_t 淘汰的页面数量
+ */
+uint16_t cache_trim(page_manager_t *self)
+{
+    if ((self->cache_max_objs == 0 && self->cache_ttl == 0) ||
+        self->anim_state.is_switch_req || self->anim_state.is_busy)
+    {
+        return 0;
+    }
+
+    // 栈中只有一个页面时没有需要保留的下层页面
+    page_base_t *keep = self->stack_top != NULL ? self->stack_top->priv.stack_next : NULL;
+    uint16_t count = 0;
+
+    while (true)
+    {
+        uint32_t used = 0;
+        page_base_t *victim = NULL;
+        bool is_expired = false;
+
+        for (page_base_t *base = self->stack_top; base != NULL; base = base->priv.stack_next)
+        {
+            if (!cache_is_hidden(self, base))
+            {
+                continue;
+            }
+
+            used += base->priv.cache_objs;
+            if (base->priv.is_pinned || base == keep)
+            {
+                continue;
+            }
+
+            if (self->cache_ttl > 0 && lv_tick_elaps(base->priv.cache_tick) >= self->cache_ttl)
+            {
+                victim = base;
+                is_expired = true;
+                break;
+            }
+
+            if (victim == NULL || base->priv.priority < victim->priv.priority ||
+                (base->priv.priority == victim->priv.priority &&
+                 (int32_t)(base->priv.cache_tick - victim->priv.cache_tick) < 0))
+            {
+                victim = base;
+            }
+        }
+
+        if (victim == NULL || (!is_expired && (self->cache_max_objs == 0 || used <= self->cache_max_objs)))
+        {
+            break;
+        }
+
+        PM_LOG_INFO("Page(%s) evicted, %s, cache objs = %d",
+                    victim->name, is_expired ? "expired" : "over budget", used);
+        PAGE_HOT_STATE(victim) = state_evict_execute(victim);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief 删除缓存超时检查任务
+ *
+ * @param self 页面管理器对象
+ */
+void cache_task_delete(page_manager_t *self)
+{
+    if (self->cache_task != NULL)
+    {
+        lv_task_del(self->cache_task);
+        self->cache_task = NULL;
+    }
+}
+
+/**
+ * @brief 设置缓存预算
+ *
+ * @param self 页面管理器对象
+ * @param max_objs lvgl对象数量,0 不限制
+ */
+void pm_set_cache_budget(page_manager_t *self, uint32_t max_objs)
+{
+    self->cache_max_objs = max_objs;
+    cache_trim(self);
+}
+
+/**
+ * @brief 设置缓存超时时间
+ *
+ * @param self 页面管理器对象
+ * @param ttl_ms 超时时间(ms),0 不按时间淘汰
+ */
+void pm_set_cache_ttl(page_manager_t *self, uint32_t ttl_ms)
+{
+    self->cache_ttl = ttl_ms;
+    if (ttl_ms == 0)
+    {
+        cache_task_delete(self);
+        return;
+    }
+
+    if (self->cache_task == NULL)
+    {
+        self->cache_task = lv_task_create(_cache_task_cb, PAGE_MANAGER_CACHE_CHECK_PERIOD, LV_TASK_PRIO_LOWEST, self);
+        if (self->cache_task == NULL)
+        {
+            PM_LOG_ERROR("cache task create failed");
+        }
+    }
+}
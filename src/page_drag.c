@@ -1,3 +1,5 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_DRAG
+
 #include "page_manager_private.h"
 #include <math.h>
 
@@ -28,9 +30,9 @@ void page_root_drag_event(lv_obj_t * obj, lv_event_t event)
     }
 
     page_manager_t *manager = base->manager;
-    page_load_anim_attr_t anim_attr;
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(manager);
 
-    if (!page_get_current_load_anim_attr(manager, &anim_attr))
+    if (anim_attr == NULL)
     {
         PM_LOG_ERROR("Can't get current anim attr");
         return;
@@ -40,40 +42,52 @@ void page_root_drag_event(lv_obj_t * obj, lv_event_t event)
         base->root_event_cb(obj, event);
     }
 
+    trace_drag(base, event);
+
+    // 拖拽开启后全局动画可能被改成不支持拖拽的类型
+    if (anim_attr->drag_dir == ROOT_DRAG_DIR_NONE || anim_attr->setter == NULL || anim_attr->getter == NULL)
+    {
+        return;
+    }
+
     switch (event)
     {
     case LV_EVENT_PRESSED:
     {
         if (manager->anim_state.is_switch_req)
             return;
+        // 每次拖拽开始时检查一次分辨率,拖拽过程中直接使用动画属性表
+        page_anim_attr_update(manager);
+        // 拖拽返回时露出下层页面,栈中只有一个页面时没有下层页面
+        page_reveal(manager->stack_top != NULL ? manager->stack_top->priv.stack_next : NULL);
         if (!manager->anim_state.is_busy)
             return;
 
         PM_LOG_INFO("Root anim interrupted");
-        lv_anim_del(obj, anim_attr.setter);
+        lv_anim_del(obj, anim_attr->setter);
         manager->anim_state.is_busy = false;
     }
     break;
     case LV_EVENT_PRESSING:
     {
-        lv_coord_t cur = anim_attr.getter(obj);
+        lv_coord_t cur = anim_attr->getter(obj);
 
-        lv_coord_t max = MAX(anim_attr.pop.exit.start, anim_attr.pop.exit.end);
-        lv_coord_t min = MIN(anim_attr.pop.exit.start, anim_attr.pop.exit.end);
+        lv_coord_t max = MAX(anim_attr->pop.exit.start, anim_attr->pop.exit.end);
+        lv_coord_t min = MIN(anim_attr->pop.exit.start, anim_attr->pop.exit.end);
 
         lv_point_t offset;
         lv_indev_get_vect(lv_indev_get_act(), &offset);
 
-        if (anim_attr.drag_dir == ROOT_DRAG_DIR_HOR)
+        if (anim_attr->drag_dir == ROOT_DRAG_DIR_HOR)
         {
             cur += offset.x;
         }
-        else if (anim_attr.drag_dir == ROOT_DRAG_DIR_VER)
+        else if (anim_attr->drag_dir == ROOT_DRAG_DIR_VER)
         {
             cur += offset.y;
         }
 
-        anim_attr.setter(obj, CONSTRAIN(cur, min, max));
+        anim_attr->setter(obj, CONSTRAIN(cur, min, max));
     }
     break;
     case LV_EVENT_RELEASED:
@@ -83,21 +97,21 @@ void page_root_drag_event(lv_obj_t * obj, lv_event_t event)
             return;
         }
 
-        lv_coord_t offset_sum = anim_attr.push.enter.end - anim_attr.push.enter.start;
+        lv_coord_t offset_sum = anim_attr->push.enter.end - anim_attr->push.enter.start;
 
         lv_coord_t x_predict = 0;
         lv_coord_t y_predict = 0;
         root_get_drag_predict(&x_predict, &y_predict);
 
-        lv_coord_t start = anim_attr.getter(obj);
+        lv_coord_t start = anim_attr->getter(obj);
         lv_coord_t end = start;
 
-        if (anim_attr.drag_dir == ROOT_DRAG_DIR_HOR)
+        if (anim_attr->drag_dir == ROOT_DRAG_DIR_HOR)
         {
             end += x_predict;
             PM_LOG_INFO("Root drag x_predict = %d", end);
         }
-        else if (anim_attr.drag_dir == ROOT_DRAG_DIR_VER)
+        else if (anim_attr->drag_dir == ROOT_DRAG_DIR_VER)
         {
             end += y_predict;
             PM_LOG_INFO("Root drag y_predict = %d", end);
@@ -107,7 +121,7 @@ void page_root_drag_event(lv_obj_t * obj, lv_event_t event)
         {
             lv_async_call(_on_root_async_leavel, base);
         }
-        else if (end != anim_attr.push.enter.end)
+        else if (end != anim_attr->push.enter.end)
         {
             manager->anim_state.is_busy = true;
 
@@ -115,12 +129,18 @@ void page_root_drag_event(lv_obj_t * obj, lv_event_t event)
             anim_default_init(manager, &a);
             a.user_data = manager;
             lv_anim_set_var(&a, obj);
-            lv_anim_set_values(&a, start, anim_attr.push.enter.end);
-            lv_anim_set_exec_cb(&a, anim_attr.setter);
+            lv_anim_set_values(&a, start, anim_attr->push.enter.end);
+            lv_anim_set_exec_cb(&a, anim_attr->setter);
             lv_anim_set_ready_cb(&a, _on_root_anim_finish);
             lv_anim_start(&a);
             PM_LOG_INFO("Root anim start");
         }
+        else
+        {
+            page_occlusion_update(manager);
+            // 按下时可能打断了回弹动画,回弹结束时本应执行的排队请求在这里执行
+            nav_queue_drain(manager);
+        }
     }
     break;
 
@@ -139,6 +159,8 @@ static void _on_root_anim_finish(lv_anim_t *a)
     page_manager_t *manager = (page_manager_t *)a->user_data;
     PM_LOG_INFO("Root anim finish");
     manager->anim_state.is_busy = false;
+    page_occlusion_update(manager);
+    nav_queue_drain(manager);
 }
 
 /**
@@ -160,8 +182,21 @@ void root_enable_drag(lv_obj_t *root)
 static void _on_root_async_leavel(void *data)
 {
     page_base_t *base = (page_base_t *)data;
-    PM_LOG_INFO("Page(%s) send event: LV_EVENT_LEAVE, need to handle...", base->name);
-    lv_event_send(base->root, LV_EVENT_LEAVE, NULL);
+    // 松开到异步回调之间页面可能已被卸载(槽位清零)或根对象已被删除
+    if (base->manager == NULL)
+    {
+        return;
+    }
+    if (base->root != NULL)
+    {
+        PM_LOG_INFO("Page(%s) send event: LV_EVENT_LEAVE, need to handle...", base->name);
+        lv_event_send(base->root, LV_EVENT_LEAVE, NULL);
+    }
+    // 页面没有在事件中切换时,执行排队的请求
+    if (base->manager != NULL)
+    {
+        nav_queue_drain(base->manager);
+    }
 }
 
 /**
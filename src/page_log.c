@@ -0,0 +1,300 @@
+#include "page_manager_private.h"
+
+#if PAGE_MANAGER_LOG_DEFERRED
+
+/* 单条日志格式化后的最大长度 */
+#define PM_LOG_LINE_MAX 160
+
+/* 单生产者单消费者环形缓冲区,写入方只修改head,读取方只修改tail */
+static pm_log_record_t _log_buf[PAGE_MANAGER_LOG_BUF_SIZE];
+static volatile uint32_t _log_head;
+static volatile uint32_t _log_tail;
+static volatile uint32_t _log_dropped;
+
+/**
+ * @brief 跳过格式字符串中转换说明符的标志、宽度和长度部分
+ *
+ * @param p 指向'%'之后的字符
+ * @return const char* 指向转换字符,格式字符串结束时指向'\0'
+ */
+static const char *_log_skip_spec(const char *p)
+{
+    while (*p != '\0' && strchr("diouxXcsp%", *p) == NULL)
+    {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 计算格式字符串中%s参数的位置掩码
+ *  @note 只在每个调用处第一次写日志时调用,写入时不再解析格式字符串
+ *
+ * @param format 格式字符串
+ * @return uint8_t 第i个参数为%s时第i位为1
+ */
+uint8_t pm_log_str_mask(const char *format)
+{
+    uint8_t mask = 0;
+    uint8_t arg = 0;
+
+    for (const char *p = format; *p != '\0' && arg < PM_LOG_ARG_MAX; p++)
+    {
+        if (*p != '%')
+        {
+            continue;
+        }
+        p = _log_skip_spec(p + 1);
+        if (*p == '\0')
+        {
+            break;
+        }
+        if (*p == '%')
+        {
+            continue;
+        }
+
+        if (*p == 's')
+        {
+            mask |= 1 << arg;
+        }
+        arg++;
+    }
+    return mask;
+}
+
+/**
+ * @brief 把%s参数指向的字符串复制到记录中
+ *  @note 调用者传入的字符串(如页面名称)在日志输出前可能已经释放,只保存指针不安全
+ *
+ * @param record 日志记录
+ * @param str_mask %s参数的位置掩码
+ */
+static void _log_copy_strings(pm_log_record_t *record, uint8_t str_mask)
+{
+    size_t used = 0;
+
+    for (uint8_t arg = 0; arg < record->argc; arg++)
+    {
+        if ((str_mask & (1 << arg)) == 0)
+        {
+            continue;
+        }
+
+        const char *str = (const char *)record->args[arg];
+        if (str == NULL)
+        {
+            record->args[arg] = PM_LOG_STR_NULL;
+        }
+        else if (used == PM_LOG_STR_SIZE)
+        {
+            /* 没有空间时指向上一个字符串的结束符 */
+            record->args[arg] = PM_LOG_STR_SIZE - 1;
+        }
+        else
+        {
+            record->args[arg] = used;
+            while (*str != '\0' && used < PM_LOG_STR_SIZE - 1)
+            {
+                record->str[used++] = *str++;
+            }
+            record->str[used++] = '\0';
+        }
+    }
+}
+
+/**
+ * @brief 写入一条延迟日志记录
+ *
+ * @param level 日志等级
+ * @param format 格式字符串
+ * @param str_mask %s参数的位置掩码
+ * @param argc 参数个数
+ * @param args 参数,参数从args[1]开始
+ */
+void pm_log_write(uint8_t level, const char *format, uint8_t str_mask, uint8_t argc, const uintptr_t *args)
+{
+    uint32_t head = _log_head;
+    if (head - __atomic_load_n(&_log_tail, __ATOMIC_ACQUIRE) >= PAGE_MANAGER_LOG_BUF_SIZE)
+    {
+        _log_dropped++;
+        return;
+    }
+
+    pm_log_record_t *record = &_log_buf[head & (PAGE_MANAGER_LOG_BUF_SIZE - 1)];
+    record->format = format;
+    record->tick = PM_TICK_US() / 1000;
+    record->level = level;
+    record->argc = (argc > PM_LOG_ARG_MAX) ? PM_LOG_ARG_MAX : argc;
+    memcpy(record->args, &args[1], record->argc * sizeof(uintptr_t));
+    if (str_mask != 0)
+    {
+        _log_copy_strings(record, str_mask);
+    }
+
+    __atomic_store_n(&_log_head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 取出一条延迟日志记录
+ *
+ * @param record [out]日志记录
+ * @return true 取出成功
+ * @return false 缓冲区为空
+ */
+bool pm_log_read(pm_log_record_t *record)
+{
+    uint32_t tail = _log_tail;
+    if (tail == __atomic_load_n(&_log_head, __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+
+    *record = _log_buf[tail & (PAGE_MANAGER_LOG_BUF_SIZE - 1)];
+    __atomic_store_n(&_log_tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief 按记录中的参数格式化一条日志
+ *  @note 逐个转换说明符交给snprintf,参数按说明符类型从uintptr_t还原
+ *
+ * @param record 日志记录
+ * @param buf 输出缓冲区
+ * @param size 输出缓冲区大小
+ */
+static void _log_format(const pm_log_record_t *record, char *buf, size_t size)
+{
+    const char *p = record->format;
+    size_t len = 0;
+    uint8_t arg = 0;
+
+    while (*p != '\0' && len + 1 < size)
+    {
+        if (*p != '%')
+        {
+            buf[len++] = *p++;
+            continue;
+        }
+
+        /* 截取单个转换说明符,例如 %-4ld */
+        char spec[16];
+        size_t n = 0;
+        spec[n++] = *p++;
+        while (*p != '\0' && strchr("diouxXcsp%", *p) == NULL && n < sizeof(spec) - 2)
+        {
+            spec[n++] = *p++;
+        }
+        char conv = *p;
+        if (conv == '\0')
+        {
+            break;
+        }
+        spec[n++] = *p++;
+        spec[n] = '\0';
+
+        int ret;
+        if (conv == '%')
+        {
+            ret = snprintf(buf + len, size - len, "%%");
+        }
+        else
+        {
+            uintptr_t v = (arg < record->argc) ? record->args[arg] : 0;
+            bool is_long = (strchr(spec, 'l') != NULL);
+            arg++;
+
+            switch (conv)
+            {
+            case 's':
+                ret = snprintf(buf + len, size - len, spec, v < PM_LOG_STR_SIZE ? record->str + v : "(null)");
+                break;
+            case 'p':
+                ret = snprintf(buf + len, size - len, spec, (void *)v);
+                break;
+            case 'd':
+            case 'i':
+            case 'c':
+                ret = is_long ? snprintf(buf + len, size - len, spec, (long)v)
+                              : snprintf(buf + len, size - len, spec, (int)v);
+                break;
+            default:
+                ret = is_long ? snprintf(buf + len, size - len, spec, (unsigned long)v)
+                              : snprintf(buf + len, size - len, spec, (unsigned int)v);
+                break;
+            }
+        }
+
+        if (ret < 0)
+        {
+            break;
+        }
+        len += ((size_t)ret < size - len) ? (size_t)ret : size - len - 1;
+    }
+    buf[len] = '\0';
+}
+
+/**
+ * @brief 格式化并输出缓冲区中的所有延迟日志
+ *
+ * @return uint32_t 输出的日志条数
+ */
+uint32_t pm_log_flush(void)
+{
+    pm_log_record_t record;
+    char line[PM_LOG_LINE_MAX];
+    uint32_t count = 0;
+
+    while (pm_log_read(&record))
+    {
+        _log_format(&record, line, sizeof(line));
+        printf("[PM][%u]%s\r\n", (unsigned int)record.tick, line);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief 获取因缓冲区满而丢弃的日志条数
+ *
+ * @return uint32_t 丢弃的日志条数
+ */
+uint32_t pm_log_get_dropped(void)
+{
+    return _log_dropped;
+}
+
+#else
+
+uint8_t pm_log_str_mask(const char *format)
+{
+    (void)format;
+    return 0;
+}
+
+void pm_log_write(uint8_t level, const char *format, uint8_t str_mask, uint8_t argc, const uintptr_t *args)
+{
+    (void)level;
+    (void)format;
+    (void)str_mask;
+    (void)argc;
+    (void)args;
+}
+
+bool pm_log_read(pm_log_record_t *record)
+{
+    (void)record;
+    return false;
+}
+
+uint32_t pm_log_flush(void)
+{
+    return 0;
+}
+
+uint32_t pm_log_get_dropped(void)
+{
+    return 0;
+}
+
+#endif
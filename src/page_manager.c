@@ -1,7 +1,26 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_MANAGER
+
 #include "page_manager_private.h"
 
 #define PM_EMPTY_PAGE_NAME "EMPTY_PAGE"
 
+/**
+ * @brief 计算页面名称哈希(FNV-1a)
+ *
+ * @param name 页面名称
+ * @return uint32_t 哈希值
+ */
+static uint32_t _page_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name != '\0')
+    {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 /**
  * @brief 创建页面管理器对象
  *
@@ -9,7 +28,18 @@
  */
 page_manager_t *page_manager_create(void)
 {
-    page_manager_t *page_manager = (page_manager_t *)PM_MALLOC(sizeof(page_manager_t));
+    return page_manager_create_with_allocator(&pm_allocator_default);
+}
+
+/**
+ * @brief 使用指定的内存分配器创建页面管理器对象
+ *
+ * @param allocator 内存分配器
+ * @return page_manager_t* 页面管理器对象
+ */
+page_manager_t *page_manager_create_with_allocator(const pm_allocator_t *allocator)
+{
+    page_manager_t *page_manager = (page_manager_t *)allocator->alloc(allocator->ctx, sizeof(page_manager_t));
     if (page_manager == NULL)
     {
         PM_LOG_ERROR("page_manager alloc error\n");
@@ -17,12 +47,97 @@ page_manager_t *page_manager_create(void)
     }
     PM_LOG_INFO("page_manager alloc sucess\n");
     memset(page_manager, 0, sizeof(page_manager_t));
-    page_manager->page_pool = listCreate();
-    listSetFreeMethod(page_manager->page_pool, page_base_delete);
-    page_manager->page_stack = listCreate();
+    page_manager->allocator = *allocator;
+    page_manager->alloc_stat.alloc_count = 1;
+    page_manager->alloc_stat.bytes_used = sizeof(page_manager_t);
+    page_manager->alloc_stat.bytes_peak = sizeof(page_manager_t);
+
+    uint32_t table_size = sizeof(page_base_t) * PAGE_MANAGER_PAGE_MAX;
+    page_manager->page_table = (page_base_t *)pm_mem_alloc(page_manager, table_size);
+    if (page_manager->page_table == NULL)
+    {
+        PM_LOG_ERROR("page_table alloc error\n");
+        allocator->free(allocator->ctx, page_manager);
+        return NULL;
+    }
+    memset(page_manager->page_table, 0, table_size);
+    page_manager->preload_budget_us = PAGE_MANAGER_PRELOAD_BUDGET_US;
+    page_anim_register_builtin(page_manager);
+    page_anim_attr_update(page_manager);
+    page_manager->cache_max_objs = PAGE_MANAGER_CACHE_MAX_OBJS;
+    pm_set_cache_ttl(page_manager, PAGE_MANAGER_CACHE_TTL);
     return page_manager;
 }
 
+/**
+ * @brief 创建绑定到指定显示器或容器的页面管理器对象
+ *
+ * @param disp 显示器,NULL时使用默认显示器
+ * @param parent 页面根对象的父对象,NULL时使用disp的活动屏幕
+ * @return page_manager_t* 页面管理器对象
+ */
+page_manager_t *page_manager_create_for(lv_disp_t *disp, lv_obj_t *parent)
+{
+    return page_manager_create_for_with_allocator(disp, parent, &pm_allocator_default);
+}
+
+/**
+ * @brief 使用指定的内存分配器创建绑定到指定显示器或容器的页面管理器对象
+ *
+ * @param disp 显示器,NULL时使用默认显示器
+ * @param parent 页面根对象的父对象,NULL时使用disp的活动屏幕
+ * @param allocator 内存分配器
+ * @return page_manager_t* 页面管理器对象
+ */
+page_manager_t *page_manager_create_for_with_allocator(lv_disp_t *disp, lv_obj_t *parent, const pm_allocator_t *allocator)
+{
+    page_manager_t *page_manager = page_manager_create_with_allocator(allocator);
+    if (page_manager == NULL)
+    {
+        return NULL;
+    }
+    page_manager->disp = disp;
+    page_manager->parent = parent;
+
+    /* 按绑定的显示器或容器重建动画属性表 */
+    page_manager->anim_attr_hor = 0;
+    page_manager->anim_attr_ver = 0;
+    page_anim_attr_update(page_manager);
+    return page_manager;
+}
+
+/**
+ * @brief 获取页面根对象的父对象
+ *
+ * @param self 页面管理器对象
+ * @return lv_obj_t* 绑定的容器,没有时返回绑定显示器的活动屏幕
+ */
+lv_obj_t *get_root_parent(page_manager_t *self)
+{
+    return self->parent != NULL ? self->parent : lv_disp_get_scr_act(self->disp);
+}
+
+/**
+ * @brief 获取页面的显示区域大小
+ *
+ * @param self 页面管理器对象
+ * @param hor [out]宽度
+ * @param ver [out]高度
+ */
+void get_resolution(page_manager_t *self, lv_coord_t *hor, lv_coord_t *ver)
+{
+    if (self->parent != NULL)
+    {
+        *hor = lv_obj_get_width(self->parent);
+        *ver = lv_obj_get_height(self->parent);
+    }
+    else
+    {
+        *hor = lv_disp_get_hor_res(self->disp);
+        *ver = lv_disp_get_ver_res(self->disp);
+    }
+}
+
 /**
  * @brief 删除页面管理器对象
  *
@@ -35,14 +150,78 @@ void page_manager_delete(page_manager_t *self)
         PM_LOG_ERROR("page_manager is NULL\n");
         return;
     }
-    listRelease(self->page_pool);
-    listRelease(self->page_stack);
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        page_base_t *base = &self->page_table[i];
+        if (base->manager == NULL)
+        {
+            continue;
+        }
+        /* 显示中或缓存的页面根对象随页面管理器一起删除,同时删除其上的动画 */
+        if (base->priv.anim.snapshot != NULL)
+        {
+            lv_obj_del(base->priv.anim.snapshot);
+        }
+        if (base->root != NULL)
+        {
+            PM_LOG_WARN("Page(%s) root still alive, delete", base->name);
+            lv_obj_del(base->root);
+            base->root = NULL;
+        }
+        page_base_delete(base);
+    }
+    nav_queue_clear(self);
+    preload_task_delete(self);
+    state_load_task_delete(self);
+    cache_task_delete(self);
+    stash_pool_clear(self);
+    pm_mem_free(self, self->page_table, sizeof(page_base_t) * PAGE_MANAGER_PAGE_MAX);
+    self->page_table = NULL;
+    self->stack_top = NULL;
+    self->stack_depth = 0;
     self->page_current = NULL;
     self->page_prev = NULL;
-    PM_FREE(self);
+    pm_allocator_t allocator = self->allocator;
+    allocator.free(allocator.ctx, self);
     PM_LOG_INFO("page_manager free sucess\n");
 }
 
+/**
+ * @brief 获取页面管理器的运行状况
+ *
+ * @param self 页面管理器对象
+ * @param health [out]运行状况
+ */
+void pm_get_health(page_manager_t *self, pm_health_t *health)
+{
+    memset(health, 0, sizeof(pm_health_t));
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        page_base_t *base = &self->page_table[i];
+        if (base->manager == NULL)
+        {
+            continue;
+        }
+        if (base->root != NULL)
+        {
+            health->root_count++;
+        }
+        if (base->priv.stash.ptr != NULL)
+        {
+            health->stash_count++;
+        }
+        if (cache_is_hidden(self, base))
+        {
+            health->cache_obj_count += base->priv.cache_objs;
+        }
+    }
+    health->page_count = self->page_count;
+    health->stack_depth = self->stack_depth;
+    health->shared_buf_count = self->shared_buf_count;
+    health->stash_pool_free = stash_pool_free_count(self);
+    health->bytes_used = self->alloc_stat.bytes_used;
+}
+
 /**
  * @brief 通过名字在页面池中到到页面对象
  *
@@ -52,41 +231,36 @@ void page_manager_delete(page_manager_t *self)
  */
 page_base_t *find_page_pool(page_manager_t *self, const char *name)
 {
-    listIter *iter = listGetIterator(self->page_pool, AL_START_HEAD);
-    for (listNode *node = listNext(iter); node != NULL; node = listNext(iter))
+    uint32_t hash = _page_name_hash(name);
+    page_base_t *base = self->page_hash[hash & (PAGE_MANAGER_HASH_SIZE - 1)];
+    for (; base != NULL; base = base->hash_next)
     {
-        if (strcmp(((page_base_t *)node->value)->name, name) == 0)
+        if (base->name_hash == hash && strcmp(base->name, name) == 0)
         {
-            PM_LOG_INFO("find object %s addr[%p]\n", name, node);
-            listReleaseIterator(iter);
-            return (page_base_t *)node->value;
+            PM_LOG_INFO("find object %s addr[%p]\n", name, base);
+            return base;
         }
     }
-    listReleaseIterator(iter);
     return NULL;
 }
 
 /**
- * @brief 从栈中找到页面
+ * @brief 通过页面句柄在页面池中找到页面对象
+ *  @note 句柄的代数与槽位不一致时,说明页面已被卸载,句柄失效
  *
  * @param self 页面管理器对象
- * @param name 页面名称
- * @return page_base_t*
+ * @param id 页面句柄
+ * @return page_base_t* 页面对象,句柄无效时返回NULL
  */
-page_base_t *find_page_stack(page_manager_t *self, const char *name)
+page_base_t *find_page_id(page_manager_t *self, pm_page_id_t id)
 {
-    listIter *iter = listGetIterator(self->page_stack, AL_START_HEAD);
-    for (listNode *node = listNext(iter); node != NULL; node = listNext(iter))
+    uint16_t index = PM_PAGE_ID_INDEX(id);
+    if (index >= PAGE_MANAGER_PAGE_MAX || self->page_table[index].manager == NULL ||
+        self->page_table[index].id != id)
     {
-        if (strcmp(((page_base_t *)node->value)->name, name) == 0)
-        {
-            PM_LOG_INFO("find object %s addr[%p]\n", name, node);
-            listReleaseIterator(iter);
-            return (page_base_t *)node->value;
-        }
+        return NULL;
     }
-    listReleaseIterator(iter);
-    return NULL;
+    return &self->page_table[index];
 }
 
 /**
@@ -94,18 +268,26 @@ page_base_t *find_page_stack(page_manager_t *self, const char *name)
  *
  * @param self 页面管理器对象
  * @param base 页面对象
+ * @return true 注册成功
+ * @return false 注册失败
  */
-static void pm_register(page_manager_t *self, page_base_t *base)
+static bool pm_register(page_manager_t *self, page_base_t *base)
 {
+    base->name_hash = _page_name_hash(base->name);
+
     if (find_page_pool(self, base->name) != NULL)
     {
         PM_LOG_ERROR("Page(%s) was multi registered", base->name);
-        return;
+        return false;
     }
 
-    base->manager = self;
-    listAddNodeTail(self->page_pool, base);
-    PM_LOG_INFO("page(%s) manager register", base->name);
+    page_base_t **bucket = &self->page_hash[base->name_hash & (PAGE_MANAGER_HASH_SIZE - 1)];
+    base->hash_next = *bucket;
+    *bucket = base;
+
+    self->page_count++;
+    PM_LOG_INFO("page(%s) manager register, id = 0x%x", base->name, (unsigned int)base->id);
+    return true;
 }
 
 /**
@@ -114,23 +296,22 @@ static void pm_register(page_manager_t *self, page_base_t *base)
  * @param self 页面管理器对象
  * @param base 页面对象
  */
-static void pm_unregister(page_manager_t *self, const char *name)
+static void pm_unregister(page_manager_t *self, page_base_t *base)
 {
-    PM_LOG_INFO("Page(%s) unregister...", name);
+    PM_LOG_INFO("Page(%s) unregister...", base->name);
 
-    page_base_t *base = find_page_stack(self, name);
-    if (base != NULL)
+    page_base_t **link = &self->page_hash[base->name_hash & (PAGE_MANAGER_HASH_SIZE - 1)];
+    while (*link != NULL && *link != base)
     {
-        PM_LOG_ERROR("Page(%s) was in recycle_pool", name);
-        return;
+        link = &(*link)->hash_next;
     }
-
-    if (find_page_pool(self, name) != NULL)
+    if (*link != NULL)
     {
-        PM_LOG_ERROR("Page(%s) was multi registered", name);
+        *link = base->hash_next;
     }
 
-    listDelNode(self->page_pool, listSearchKey(self->page_pool, base));
+    self->page_count--;
+    base->hash_next = NULL;
     PM_LOG_INFO("Unregister OK");
 }
 
@@ -138,23 +319,29 @@ static void pm_unregister(page_manager_t *self, const char *name)
  * @brief 安装页面到页面管理器中
  *
  * @param self 页面管理器对象
+ * @param name 页面名称
  * @param page_param 页面调度函数
+ * @return pm_page_id_t 页面句柄
  */
-void pm_install(page_manager_t *self, const char *name, page_vtable_t* page_param)
+pm_page_id_t pm_install(page_manager_t *self, const char *name, page_vtable_t* page_param)
 {
-    page_base_t *page_base = page_base_create();
+    page_base_t *page_base = page_base_create(self);
+    if (page_base == NULL)
+    {
+        return PM_PAGE_ID_INVALID;
+    }
 
     page_base->base = page_param;
     page_base->name = name;
-    page_base->manager = NULL;
-    page_base->root = NULL;
-    page_base->root_event_cb = NULL;
-    page_base->user_data = NULL;
-    memset(&page_base->priv, 0, sizeof(page_base->priv));
 
     page_base->base->on_custom_attr_config(page_base);
 
-    pm_register(self, page_base);
+    if (!pm_register(self, page_base))
+    {
+        page_base_delete(page_base);
+        return PM_PAGE_ID_INVALID;
+    }
+    return page_base->id;
 }
 
 /**
@@ -165,30 +352,81 @@ void pm_install(page_manager_t *self, const char *name, page_vtable_t* page_para
  */
 void pm_uninstall(page_manager_t *self, const char *name)
 {
-    PM_LOG_INFO("Page(%s) uninstall...", name);
-    page_base_t *base = find_page_pool(self, name);
-    if (base == NULL)
+    pm_page_id_t id = pm_get_page_id(self, name);
+    if (id == PM_PAGE_ID_INVALID)
     {
         PM_LOG_ERROR("Page(%s) was not found", name);
         return;
     }
+    pm_uninstall_id(self, id);
+}
+
+/**
+ * @brief 通过页面句柄卸载页面
+ *
+ * @param self 页面管理器对象
+ * @param id 页面句柄
+ */
+void pm_uninstall_id(page_manager_t *self, pm_page_id_t id)
+{
+    page_base_t *base = find_page_id(self, id);
+    if (base == NULL)
+    {
+        PM_LOG_ERROR("Page id(0x%x) was not found", (unsigned int)id);
+        return;
+    }
 
-    pm_unregister(self, name);
+    PM_LOG_INFO("Page(%s) uninstall...", base->name);
 
-    if (base->priv.is_cached)
+    if (PAGE_HOT_IS_IN_STACK(base))
     {
-        PM_LOG_WARN("Page(%s) has cached, unloading...", name);
-        base->priv.state = PAGE_STATE_UNLOAD;
+        PM_LOG_ERROR("Page(%s) was in page stack", base->name);
+        return;
+    }
+
+    // 刚被pop的页面退出动画还在播放,删除根对象会使切换无法结束
+    if (PAGE_HOT_IS_BUSY(base))
+    {
+        PM_LOG_ERROR("Page(%s) is busy", base->name);
+        return;
+    }
+
+    // 未缓存的页面退出动画结束前也持有根对象
+    if (base->root != NULL)
+    {
+        PM_LOG_WARN("Page(%s) has root, unloading...", base->name);
+        PAGE_HOT_STATE(base) = PAGE_STATE_UNLOAD;
         page_state_update(self, base);
     }
     else
     {
-        PM_LOG_INFO("Page(%s) has not cache", name);
+        PM_LOG_INFO("Page(%s) has not cache", base->name);
     }
 
+    if (self->page_prev == base)
+    {
+        self->page_prev = NULL;
+    }
+
+    pm_unregister(self, base);
+    page_base_delete(base);
+
     PM_LOG_INFO("Uninstall OK");
 }
 
+/**
+ * @brief 通过页面名称获取页面句柄
+ *
+ * @param self 页面管理器对象
+ * @param name 页面名称
+ * @return pm_page_id_t 页面句柄
+ */
+pm_page_id_t pm_get_page_id(page_manager_t *self, const char *name)
+{
+    page_base_t *base = find_page_pool(self, name);
+    return (base != NULL) ? base->id : PM_PAGE_ID_INVALID;
+}
+
 /**
  * @brief 获取上一个页面的名字
  *
@@ -205,74 +443,66 @@ const char *get_page_prev_name(page_manager_t *self)
 }
 
 /**
- * @brief 获取栈顶页面
+ * @brief 页面压栈
  *
  * @param self 页面管理器对象
- * @return page_base_t* 页面对象
+ * @param base 页面对象
  */
-page_base_t *get_stack_top(page_manager_t *self)
+void stack_push(page_manager_t *self, page_base_t *base)
+{
+    base->priv.stack_next = self->stack_top;
+    PAGE_HOT_IS_IN_STACK(base) = true;
+    self->stack_top = base;
+    self->stack_depth++;
+}
+
+/**
+ * @brief 栈顶页面出栈
+ *
+ * @param self 页面管理器对象
+ * @return page_base_t* 出栈的页面对象,栈为空时返回NULL
+ */
+page_base_t *stack_pop(page_manager_t *self)
 {
-    listNode *base_node = listIndex(self->page_stack, 0);
-    if (base_node == NULL)
+    page_base_t *top = self->stack_top;
+    if (top == NULL)
     {
-        PM_LOG_ERROR("page_manage is empty");
         return NULL;
     }
-    return (page_base_t *)base_node->value;
+    self->stack_top = top->priv.stack_next;
+    self->stack_depth--;
+    top->priv.stack_next = NULL;
+    PAGE_HOT_IS_IN_STACK(top) = false;
+    return top;
 }
 
 /**
- * @brief 获取栈顶页面后面的页面
+ * @brief 获取栈顶页面
  *
  * @param self 页面管理器对象
  * @return page_base_t* 页面对象
  */
-page_base_t *get_stack_top_after(page_manager_t *self)
+page_base_t *get_stack_top(page_manager_t *self)
 {
-    listNode *base_node = listIndex(self->page_stack, 1);
-    if (base_node == NULL)
+    if (self->stack_top == NULL)
     {
-        PM_LOG_ERROR("page_manage is empty or only heve one page");
-        return NULL;
+        PM_LOG_ERROR("page_manage is empty");
     }
-    return (page_base_t *)base_node->value;
+    return self->stack_top;
 }
 
 /**
- * @brief 清除页面
- * 
+ * @brief 获取栈顶页面后面的页面
+ *
  * @param self 页面管理器对象
- * @param keep_bottom 是否保留栈底页面
+ * @return page_base_t* 页面对象
  */
-void set_satck_clear(page_manager_t *self, bool keep_bottom)
+page_base_t *get_stack_top_after(page_manager_t *self)
 {
-    while (1)
+    if (self->stack_top == NULL || self->stack_top->priv.stack_next == NULL)
     {
-        page_base_t *top = get_stack_top(self);
-        if (top == NULL)
-        {
-            PM_LOG_INFO("Page stack is empty, breaking...");
-            break;
-        }
-
-        page_base_t *top_after = get_stack_top_after(self);
-
-        if (top_after == NULL)
-        {
-            if (keep_bottom)
-            {
-                self->page_prev = top;
-                PM_LOG_INFO("Keep page stack bottom(%s), breaking...", top->name);
-                break;
-            }
-            else
-            {
-                self->page_prev = NULL;
-            }
-        }
-
-        fource_unload(top);
-        listDelNode(self->page_stack, listSearchKey(self->page_stack, top));
+        PM_LOG_ERROR("page_manage is empty or only heve one page");
+        return NULL;
     }
-    PM_LOG_INFO("Stack clear done");
-}
\ No newline at end of file
+    return self->stack_top->priv.stack_next;
+}
@@ -0,0 +1,399 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_MEM
+
+#include "page_manager_private.h"
+
+/* 内存池中每块内存前的头部,记录块容量(对齐后的字节数),保持对齐 */
+typedef union
+{
+    size_t capacity;
+    void *align_ptr;
+    long double align_ld;
+} pm_arena_header_t;
+
+/* 空闲块的下一个空闲块保存在块的数据区 */
+#define ARENA_FREE_NEXT(header) (*(pm_arena_header_t **)((header) + 1))
+/* 块的结束地址 */
+#define ARENA_BLOCK_END(header) ((uint8_t *)((header) + 1) + (header)->capacity)
+
+static void *_default_alloc(void *ctx, size_t size);
+static void _default_free(void *ctx, void *ptr);
+static void *_default_realloc(void *ctx, void *ptr, size_t size);
+static void *_libc_alloc(void *ctx, size_t size);
+static void _libc_free(void *ctx, void *ptr);
+static void *_libc_realloc(void *ctx, void *ptr, size_t size);
+static void *_lvgl_alloc(void *ctx, size_t size);
+static void _lvgl_free(void *ctx, void *ptr);
+static void *_lvgl_realloc(void *ctx, void *ptr, size_t size);
+static void *_arena_alloc(void *ctx, size_t size);
+static void _arena_free(void *ctx, void *ptr);
+static void *_arena_realloc(void *ctx, void *ptr, size_t size);
+
+const pm_allocator_t pm_allocator_default = {_default_alloc, _default_free, _default_realloc, NULL};
+const pm_allocator_t pm_allocator_libc = {_libc_alloc, _libc_free, _libc_realloc, NULL};
+const pm_allocator_t pm_allocator_lvgl = {_lvgl_alloc, _lvgl_free, _lvgl_realloc, NULL};
+
+/**
+ * @brief 记录一次内存申请
+ *
+ * @param self 页面管理器对象
+ * @param size 申请的字节数
+ */
+static void _alloc_stat_add(page_manager_t *self, uint32_t size)
+{
+    self->alloc_stat.alloc_count++;
+    self->alloc_stat.bytes_used += size;
+    if (self->alloc_stat.bytes_used > self->alloc_stat.bytes_peak)
+    {
+        self->alloc_stat.bytes_peak = self->alloc_stat.bytes_used;
+    }
+}
+
+/**
+ * @brief 检查内存申请是否被锁定
+ *
+ * @param self 页面管理器对象
+ * @param size 申请的字节数
+ */
+static void _alloc_lock_check(page_manager_t *self, uint32_t size)
+{
+    if (self->alloc_locked)
+    {
+        PM_LOG_ERROR("alloc[%d] while page_manager allocation is locked", size);
+        self->alloc_stat.locked_alloc_count++;
+    }
+}
+
+/**
+ * @brief 通过页面管理器的分配器申请内存并记录到内存统计中
+ *
+ * @param self 页面管理器对象
+ * @param size 申请的字节数
+ * @return void* 内存地址,失败返回NULL
+ */
+void *pm_mem_alloc(page_manager_t *self, uint32_t size)
+{
+    _alloc_lock_check(self, size);
+
+    void *ptr = self->allocator.alloc(self->allocator.ctx, size);
+    if (ptr == NULL)
+    {
+        PM_LOG_ERROR("alloc[%d] failed", size);
+        return NULL;
+    }
+
+    _alloc_stat_add(self, size);
+    return ptr;
+}
+
+/**
+ * @brief 通过页面管理器的分配器释放内存并记录到内存统计中
+ *
+ * @param self 页面管理器对象
+ * @param ptr 内存地址
+ * @param size 申请时的字节数
+ */
+void pm_mem_free(page_manager_t *self, void *ptr, uint32_t size)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    self->allocator.free(self->allocator.ctx, ptr);
+    self->alloc_stat.free_count++;
+    self->alloc_stat.bytes_used -= size;
+}
+
+/**
+ * @brief 获取页面管理器的内存统计
+ *
+ * @param self 页面管理器对象
+ * @param stat [out]内存统计
+ */
+void pm_get_alloc_stat(page_manager_t *self, pm_alloc_stat_t *stat)
+{
+    *stat = self->alloc_stat;
+}
+
+/**
+ * @brief 锁定页面管理器的内存申请
+ *  @note 预热完成后开启,此后每次申请都会打印错误并计入locked_alloc_count,
+ *        用于验证缓存页面之间的push/pop不产生堆内存申请
+ *
+ * @param self 页面管理器对象
+ * @param en 是否锁定
+ */
+void pm_set_alloc_locked(page_manager_t *self, bool en)
+{
+    self->alloc_locked = en;
+}
+
+static void *_default_alloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    return PM_MALLOC(size);
+}
+
+static void _default_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    PM_FREE(ptr);
+}
+
+static void *_default_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    return PM_REALLOC(ptr, size);
+}
+
+static void *_libc_alloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    return malloc(size);
+}
+
+static void _libc_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    free(ptr);
+}
+
+static void *_libc_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void *_lvgl_alloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    return lv_mem_alloc(size);
+}
+
+static void _lvgl_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    lv_mem_free(ptr);
+}
+
+static void *_lvgl_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    return lv_mem_realloc(ptr, size);
+}
+
+/**
+ * @brief 在用户提供的内存区上初始化内存池,并生成对应的分配器
+ *
+ * @param arena 内存池对象
+ * @param buf 内存区
+ * @param size 内存区大小
+ * @param allocator [out]使用该内存池的分配器
+ */
+void pm_arena_init(pm_arena_t *arena, void *buf, size_t size, pm_allocator_t *allocator)
+{
+    /* 内存区起始地址按头部对齐 */
+    size_t pad = (sizeof(pm_arena_header_t) - ((uintptr_t)buf % sizeof(pm_arena_header_t))) % sizeof(pm_arena_header_t);
+    if (pad > size)
+    {
+        pad = size;
+    }
+    arena->buf = (uint8_t *)buf + pad;
+    arena->size = size - pad;
+    arena->used = 0;
+    arena->free_list = NULL;
+
+    allocator->alloc = _arena_alloc;
+    allocator->free = _arena_free;
+    allocator->realloc = _arena_realloc;
+    allocator->ctx = arena;
+}
+
+/**
+ * @brief 块容量按头部大小对齐,至少能放下空闲链表指针
+ *
+ * @param size 申请的字节数
+ * @return size_t 对齐后的块容量
+ */
+static size_t _arena_align(size_t size)
+{
+    if (size == 0)
+    {
+        size = 1;
+    }
+    return (size + sizeof(pm_arena_header_t) - 1) / sizeof(pm_arena_header_t) * sizeof(pm_arena_header_t);
+}
+
+/**
+ * @brief 判断内存块是否是内存池中最后申请的块
+ *
+ * @param arena 内存池对象
+ * @param header 块头部
+ * @return true 是最后的块
+ * @return false 不是最后的块
+ */
+static bool _arena_is_last(pm_arena_t *arena, pm_arena_header_t *header)
+{
+    return ARENA_BLOCK_END(header) == arena->buf + arena->used;
+}
+
+/**
+ * @brief 从空闲链表首次适配一个块,剩余部分足够放下一个最小块时拆分
+ *
+ * @param arena 内存池对象
+ * @param capacity 对齐后的块容量
+ * @return pm_arena_header_t* 块头部,没有合适的空闲块时返回NULL
+ */
+static pm_arena_header_t *_arena_free_list_take(pm_arena_t *arena, size_t capacity)
+{
+    pm_arena_header_t **link = (pm_arena_header_t **)&arena->free_list;
+    while (*link != NULL)
+    {
+        pm_arena_header_t *header = *link;
+        if (header->capacity >= capacity)
+        {
+            size_t remain = header->capacity - capacity;
+            if (remain >= 2 * sizeof(pm_arena_header_t))
+            {
+                pm_arena_header_t *rest = (pm_arena_header_t *)((uint8_t *)(header + 1) + capacity);
+                rest->capacity = remain - sizeof(pm_arena_header_t);
+                ARENA_FREE_NEXT(rest) = ARENA_FREE_NEXT(header);
+                *link = rest;
+                header->capacity = capacity;
+            }
+            else
+            {
+                *link = ARENA_FREE_NEXT(header);
+            }
+            return header;
+        }
+        link = &ARENA_FREE_NEXT(header);
+    }
+    return NULL;
+}
+
+/**
+ * @brief 空闲链表末尾的块紧挨着线性申请的末尾时退回给线性区域
+ *
+ * @param arena 内存池对象
+ */
+static void _arena_trim(pm_arena_t *arena)
+{
+    pm_arena_header_t **link = (pm_arena_header_t **)&arena->free_list;
+    while (*link != NULL && ARENA_FREE_NEXT(*link) != NULL)
+    {
+        link = &ARENA_FREE_NEXT(*link);
+    }
+    if (*link != NULL && _arena_is_last(arena, *link))
+    {
+        arena->used = (uint8_t *)*link - arena->buf;
+        *link = NULL;
+    }
+}
+
+static void *_arena_alloc(void *ctx, size_t size)
+{
+    pm_arena_t *arena = (pm_arena_t *)ctx;
+    size_t capacity = _arena_align(size);
+
+    pm_arena_header_t *header = _arena_free_list_take(arena, capacity);
+    if (header != NULL)
+    {
+        return header + 1;
+    }
+
+    size_t need = sizeof(pm_arena_header_t) + capacity;
+    if (arena->size - arena->used < need)
+    {
+        PM_LOG_ERROR("arena is full, used[%d] need[%d]", (int)arena->used, (int)need);
+        return NULL;
+    }
+
+    header = (pm_arena_header_t *)(arena->buf + arena->used);
+    header->capacity = capacity;
+    arena->used += need;
+    return header + 1;
+}
+
+static void _arena_free(void *ctx, void *ptr)
+{
+    pm_arena_t *arena = (pm_arena_t *)ctx;
+    pm_arena_header_t *header = (pm_arena_header_t *)ptr - 1;
+
+    /* 最后申请的块直接退回,之前释放的末尾空闲块随之退回 */
+    if (_arena_is_last(arena, header))
+    {
+        arena->used = (uint8_t *)header - arena->buf;
+        _arena_trim(arena);
+        return;
+    }
+
+    /* 按地址插入空闲链表,与前后相邻的空闲块合并 */
+    pm_arena_header_t *prev = NULL;
+    pm_arena_header_t *next = (pm_arena_header_t *)arena->free_list;
+    while (next != NULL && next < header)
+    {
+        prev = next;
+        next = ARENA_FREE_NEXT(next);
+    }
+
+    if (next != NULL && ARENA_BLOCK_END(header) == (uint8_t *)next)
+    {
+        header->capacity += sizeof(pm_arena_header_t) + next->capacity;
+        next = ARENA_FREE_NEXT(next);
+    }
+    ARENA_FREE_NEXT(header) = next;
+
+    if (prev != NULL && ARENA_BLOCK_END(prev) == (uint8_t *)header)
+    {
+        prev->capacity += sizeof(pm_arena_header_t) + header->capacity;
+        ARENA_FREE_NEXT(prev) = next;
+    }
+    else if (prev != NULL)
+    {
+        ARENA_FREE_NEXT(prev) = header;
+    }
+    else
+    {
+        arena->free_list = header;
+    }
+}
+
+static void *_arena_realloc(void *ctx, void *ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        return _arena_alloc(ctx, size);
+    }
+
+    pm_arena_t *arena = (pm_arena_t *)ctx;
+    pm_arena_header_t *header = (pm_arena_header_t *)ptr - 1;
+    size_t capacity = _arena_align(size);
+
+    /* 最后申请的块直接原地伸缩 */
+    if (_arena_is_last(arena, header))
+    {
+        size_t offset = (uint8_t *)(header + 1) - arena->buf;
+        if (arena->size - offset < capacity)
+        {
+            return NULL;
+        }
+        header->capacity = capacity;
+        arena->used = offset + capacity;
+        return ptr;
+    }
+
+    /* 容量足够时原地使用 */
+    if (capacity <= header->capacity)
+    {
+        return ptr;
+    }
+
+    void *new_ptr = _arena_alloc(ctx, size);
+    if (new_ptr != NULL)
+    {
+        memcpy(new_ptr, ptr, header->capacity < size ? header->capacity : size);
+        _arena_free(ctx, ptr);
+    }
+    return new_ptr;
+}
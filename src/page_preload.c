@@ -0,0 +1,156 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_PRELOAD
+
+#include "page_manager_private.h"
+
+/**
+ * @brief 预加载任务,切换动画和拖拽期间不执行,每帧在时间预算内依次加载等待中的页面
+ *  @note 预算在每个on_view_load_step之间检查,分帧构建的大页面不会一次占满一帧
+ *
+ * @param task lvgl任务
+ */
+static void _preload_task_cb(lv_task_t *task)
+{
+    page_manager_t *self = (page_manager_t *)task->user_data;
+
+    if (self->anim_state.is_switch_req || self->anim_state.is_busy)
+    {
+        return;
+    }
+
+    uint32_t start = PM_TICK_US();
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        page_base_t *base = &self->page_table[i];
+        if (base->manager == NULL ||
+            (base->priv.preload != PAGE_PRELOAD_PENDING && base->priv.preload != PAGE_PRELOAD_BUILDING))
+        {
+            continue;
+        }
+
+        PAGE_HOT_STATE(base) = state_preload_execute(base, start);
+
+        if (PM_TICK_US() - start >= self->preload_budget_us)
+        {
+            PM_LOG_INFO("Preload budget used up, continue next frame");
+            return;
+        }
+    }
+
+    PM_LOG_INFO("Preload finished");
+    preload_task_delete(self);
+}
+
+/**
+ * @brief 删除预加载任务
+ *
+ * @param self 页面管理器对象
+ */
+void preload_task_delete(page_manager_t *self)
+{
+    if (self->preload_task != NULL)
+    {
+        lv_task_del(self->preload_task);
+        self->preload_task = NULL;
+    }
+}
+
+/**
+ * @brief 在空闲帧中预加载页面
+ *
+ * @param self 页面管理器对象
+ * @param name 页面名称
+ * @return true 已加入预加载或已经加载
+ * @return false 页面未安装或正在显示
+ */
+bool pm_preload(page_manager_t *self, const char *name)
+{
+    page_base_t *base = find_page_pool(self, name);
+    if (base == NULL)
+    {
+        PM_LOG_ERROR("Page(%s) was not install", name);
+        return false;
+    }
+
+    if (base->priv.preload != PAGE_PRELOAD_NONE || PAGE_HOT_IS_CACHED(base))
+    {
+        PM_LOG_INFO("Page(%s) was already loaded", name);
+        return true;
+    }
+
+    if (PAGE_HOT_IS_IN_STACK(base) || base->root != NULL)
+    {
+        PM_LOG_WARN("Page(%s) is showing, cat't preload", name);
+        return false;
+    }
+
+    if (self->preload_task == NULL)
+    {
+        self->preload_task = lv_task_create(_preload_task_cb, PAGE_MANAGER_PRELOAD_PERIOD, LV_TASK_PRIO_LOWEST, self);
+        if (self->preload_task == NULL)
+        {
+            PM_LOG_ERROR("preload task create failed");
+            return false;
+        }
+    }
+
+    base->priv.preload = PAGE_PRELOAD_PENDING;
+    PM_LOG_INFO("Page(%s) preload pending", name);
+    return true;
+}
+
+/**
+ * @brief 取消预加载,已经加载完成的页面会被卸载
+ *  @note 分帧构建中的页面删除已创建的根对象
+ *
+ * @param self 页面管理器对象
+ * @param name 页面名称
+ * @return true 取消成功
+ * @return false 页面没有预加载或已经被push
+ */
+bool pm_preload_cancel(page_manager_t *self, const char *name)
+{
+    page_base_t *base = find_page_pool(self, name);
+    if (base == NULL)
+    {
+        PM_LOG_ERROR("Page(%s) was not install", name);
+        return false;
+    }
+
+    switch (base->priv.preload)
+    {
+    case PAGE_PRELOAD_PENDING:
+        base->priv.preload = PAGE_PRELOAD_NONE;
+        PM_LOG_INFO("Page(%s) preload canceled", name);
+        return true;
+
+    case PAGE_PRELOAD_BUILDING:
+        PM_LOG_INFO("Page(%s) preload canceled while building, unloading...", name);
+        PAGE_HOT_STATE(base) = PAGE_STATE_UNLOAD;
+        page_state_update(self, base);
+        return true;
+
+    case PAGE_PRELOAD_DONE:
+        if (PAGE_HOT_IS_IN_STACK(base))
+        {
+            return false;
+        }
+        PM_LOG_INFO("Page(%s) preload canceled, unloading...", name);
+        PAGE_HOT_STATE(base) = PAGE_STATE_UNLOAD;
+        page_state_update(self, base);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief 设置预加载每帧的时间预算
+ *
+ * @param self 页面管理器对象
+ * @param budget_us 时间预算(us)
+ */
+void pm_set_preload_budget(page_manager_t *self, uint32_t budget_us)
+{
+    self->preload_budget_us = budget_us;
+}
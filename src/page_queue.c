@@ -0,0 +1,371 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_QUEUE
+
+#include "page_manager_private.h"
+
+#if PAGE_MANAGER_NAV_QUEUE_SIZE > 0
+
+#define NAV_QUEUE_AT(self, i) (&(self)->nav_queue.cmd[((self)->nav_queue.head + (i)) % PAGE_MANAGER_NAV_QUEUE_SIZE])
+
+/**
+ * @brief 获取队尾请求
+ *
+ * @param self 页面管理器对象
+ * @return pm_nav_cmd_t* 队尾请求,队列为空时返回NULL
+ */
+static pm_nav_cmd_t *_nav_queue_tail(page_manager_t *self)
+{
+    if (self->nav_queue.count == 0)
+    {
+        return NULL;
+    }
+    return NAV_QUEUE_AT(self, self->nav_queue.count - 1);
+}
+
+/**
+ * @brief 释放请求携带的数据块
+ *  @note 转交的数据块调用释放回调,共享数据块减少一次引用
+ *
+ * @param self 页面管理器对象
+ * @param stash 请求携带的数据块
+ */
+static void _nav_stash_release(page_manager_t *self, pm_nav_stash_t *stash)
+{
+    switch (stash->type)
+    {
+    case PAGE_STASH_HEAP:
+        if (stash->stash.ptr != NULL)
+        {
+            pm_mem_free(self, stash->stash.ptr, stash->stash.size);
+        }
+        break;
+    case PAGE_STASH_MOVED:
+        if (stash->owner.free_cb != NULL)
+        {
+            stash->owner.free_cb(stash->stash.ptr);
+        }
+        break;
+    case PAGE_STASH_SHARED:
+        pm_shared_buf_release(stash->owner.shared);
+        break;
+    default:
+        break;
+    }
+    stash->type = PAGE_STASH_NONE;
+}
+
+/**
+ * @brief 把请求携带的数据块交给页面
+ *
+ * @param self 页面管理器对象
+ * @param base 页面对象
+ * @param stash 请求携带的数据块
+ */
+static void _nav_stash_apply(page_manager_t *self, page_base_t *base, pm_nav_stash_t *stash)
+{
+    switch (stash->type)
+    {
+    case PAGE_STASH_HEAP:
+        stash_store(base, &stash->stash);
+        _nav_stash_release(self, stash);
+        break;
+    case PAGE_STASH_MOVED:
+        stash_move(base, stash->stash.ptr, stash->stash.size, stash->owner.free_cb);
+        break;
+    case PAGE_STASH_SHARED:
+        stash_share(base, stash->owner.shared);
+        pm_shared_buf_release(stash->owner.shared);
+        break;
+    default:
+        break;
+    }
+    stash->type = PAGE_STASH_NONE;
+}
+
+/**
+ * @brief 检查队尾的push请求执行时能否推送页面
+ *  @note 页面已在栈中或前面已有推送同一页面的请求时,执行时会被拒绝,不能与pop抵消
+ *
+ * @param self 页面管理器对象
+ * @param cmd 队尾的push请求
+ * @return true 可以推送
+ */
+static bool _nav_queue_push_is_valid(page_manager_t *self, pm_nav_cmd_t *cmd)
+{
+    page_base_t *base = find_page_id(self, cmd->id);
+    if (base == NULL || PAGE_HOT_IS_IN_STACK(base))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i + 1 < self->nav_queue.count; i++)
+    {
+        pm_nav_cmd_t *prev = NAV_QUEUE_AT(self, i);
+        if ((prev->type == PM_NAV_PUSH || prev->type == PM_NAV_REPLACE) && prev->id == cmd->id)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 撤销队尾的push请求,释放它携带的数据块
+ *
+ * @param self 页面管理器对象
+ * @param cmd push请求
+ */
+static void _nav_queue_cancel_push(page_manager_t *self, pm_nav_cmd_t *cmd)
+{
+    _nav_stash_release(self, &cmd->stash);
+    PM_LOG_INFO("Page id(0x%x) push canceled by pop", (unsigned int)cmd->id);
+    self->nav_queue.count--;
+}
+
+/**
+ * @brief 在队尾追加请求
+ *
+ * @param self 页面管理器对象
+ * @param type 请求类型
+ * @param id 目标页面句柄
+ * @param n 回退层数
+ * @return pm_nav_cmd_t* 追加的请求,队列已满时返回NULL
+ */
+static pm_nav_cmd_t *_nav_queue_append(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, uint16_t n)
+{
+    if (self->nav_queue.count == PAGE_MANAGER_NAV_QUEUE_SIZE)
+    {
+        PM_LOG_WARN("Nav queue is full, request(%d) dropped", type);
+        return NULL;
+    }
+
+    pm_nav_cmd_t *cmd = NAV_QUEUE_AT(self, self->nav_queue.count);
+    cmd->type = (uint8_t)type;
+    cmd->id = id;
+    cmd->n = n;
+    cmd->stash.type = PAGE_STASH_NONE;
+    self->nav_queue.count++;
+    PM_LOG_INFO("Nav request(%d) queued, count = %d", type, self->nav_queue.count);
+    return cmd;
+}
+
+/**
+ * @brief 页面切换期间把导航请求放入队列,与队尾请求合并
+ *  @note push后紧接pop会相互抵消,连续的pop合并为一次多层回退,
+ *        返回栈底会吸收之前的pop
+ *
+ * @param self 页面管理器对象
+ * @param type 请求类型
+ * @param id 目标页面句柄
+ * @param n 回退层数
+ * @return true 已放入队列或被合并
+ * @return false 队列已满
+ */
+bool nav_queue_post(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, uint16_t n)
+{
+    pm_nav_cmd_t *tail = _nav_queue_tail(self);
+
+    if (type == PM_NAV_POP)
+    {
+        while (n > 0 && tail != NULL && tail->type == PM_NAV_PUSH && _nav_queue_push_is_valid(self, tail))
+        {
+            _nav_queue_cancel_push(self, tail);
+            tail = _nav_queue_tail(self);
+            n--;
+        }
+        if (n == 0)
+        {
+            return true;
+        }
+        if (tail != NULL && tail->type == PM_NAV_POP)
+        {
+            // 回退层数饱和,执行时再按栈深度截断
+            tail->n = (uint32_t)tail->n + n > UINT16_MAX ? UINT16_MAX : tail->n + n;
+            PM_LOG_INFO("Nav pop merged, n = %d", tail->n);
+            return true;
+        }
+        if (tail != NULL && tail->type == PM_NAV_HOME)
+        {
+            PM_LOG_INFO("Nav pop after home, ignored");
+            return true;
+        }
+    }
+    else if (type == PM_NAV_HOME)
+    {
+        while (tail != NULL && (tail->type == PM_NAV_POP || tail->type == PM_NAV_HOME))
+        {
+            self->nav_queue.count--;
+            tail = _nav_queue_tail(self);
+        }
+    }
+
+    return _nav_queue_append(self, type, id, n) != NULL;
+}
+
+/**
+ * @brief 页面切换期间把push/replace请求和它的数据块放入队列
+ *  @note 数据块由请求持有,执行时才交给页面,PAGE_STASH_HEAP类型的数据块在入队时复制,
+ *        共享数据块增加一次引用
+ *
+ * @param self 页面管理器对象
+ * @param type 请求类型,PM_NAV_PUSH或PM_NAV_REPLACE
+ * @param id 目标页面句柄
+ * @param stash 数据块,类型为PAGE_STASH_NONE时不携带数据块
+ * @return true 已放入队列,转交的数据块归页面管理器所有
+ * @return false 队列已满或复制失败,数据块仍归调用者所有
+ */
+bool nav_queue_post_push(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, const pm_nav_stash_t *stash)
+{
+    pm_nav_cmd_t *cmd = _nav_queue_append(self, type, id, 0);
+    if (cmd == NULL)
+    {
+        return false;
+    }
+
+    cmd->stash = *stash;
+    if (stash->type == PAGE_STASH_HEAP && stash->stash.size > 0)
+    {
+        cmd->stash.stash.ptr = pm_mem_alloc(self, stash->stash.size);
+        if (cmd->stash.stash.ptr == NULL)
+        {
+            PM_LOG_ERROR("stash malloc failed, request(%d) dropped", type);
+            self->nav_queue.count--;
+            return false;
+        }
+        memcpy(cmd->stash.stash.ptr, stash->stash.ptr, stash->stash.size);
+    }
+    else if (stash->type == PAGE_STASH_HEAP)
+    {
+        cmd->stash.stash.ptr = NULL;
+    }
+    else if (stash->type == PAGE_STASH_SHARED)
+    {
+        pm_shared_buf_retain(stash->owner.shared);
+    }
+    return true;
+}
+
+/**
+ * @brief 执行排队的push/replace请求,页面不能推送时释放请求携带的数据块
+ *
+ * @param self 页面管理器对象
+ * @param cmd 请求
+ */
+static void _nav_queue_push_execute(page_manager_t *self, pm_nav_cmd_t *cmd)
+{
+    page_base_t *base = find_page_id(self, cmd->id);
+    if (base == NULL || PAGE_HOT_IS_IN_STACK(base))
+    {
+        PM_LOG_WARN("Page id(0x%x) can't be pushed, request(%d) dropped", (unsigned int)cmd->id, cmd->type);
+        _nav_stash_release(self, &cmd->stash);
+        return;
+    }
+
+    _nav_stash_apply(self, base, &cmd->stash);
+    if (cmd->type == PM_NAV_PUSH)
+    {
+        pm_push_id(self, cmd->id, NULL);
+    }
+    else
+    {
+        pm_replace(self, base->name, NULL);
+    }
+}
+
+/**
+ * @brief 页面切换结束后依次执行队列中的请求,直到有新的切换开始
+ *
+ * @param self 页面管理器对象
+ */
+void nav_queue_drain(page_manager_t *self)
+{
+    while (self->nav_queue.count > 0 && !self->anim_state.is_switch_req && !self->anim_state.is_busy)
+    {
+        pm_nav_cmd_t cmd = self->nav_queue.cmd[self->nav_queue.head];
+        self->nav_queue.head = (self->nav_queue.head + 1) % PAGE_MANAGER_NAV_QUEUE_SIZE;
+        self->nav_queue.count--;
+
+        PM_LOG_INFO("Nav request(%d) execute", cmd.type);
+        switch (cmd.type)
+        {
+        case PM_NAV_PUSH:
+        case PM_NAV_REPLACE:
+            _nav_queue_push_execute(self, &cmd);
+            break;
+        case PM_NAV_POP:
+            pm_pop_n(self, cmd.n);
+            break;
+        case PM_NAV_POP_TO:
+            pm_pop_to_id(self, cmd.id);
+            break;
+        case PM_NAV_HOME:
+            pm_back_home(self);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 检查导航队列是否为空
+ *
+ * @param self 页面管理器对象
+ * @return true 没有排队的请求
+ */
+bool nav_queue_is_empty(page_manager_t *self)
+{
+    return self->nav_queue.count == 0;
+}
+
+/**
+ * @brief 丢弃队列中的所有请求,释放它们携带的数据块
+ *
+ * @param self 页面管理器对象
+ */
+void nav_queue_clear(page_manager_t *self)
+{
+    while (self->nav_queue.count > 0)
+    {
+        _nav_stash_release(self, &self->nav_queue.cmd[self->nav_queue.head].stash);
+        self->nav_queue.head = (self->nav_queue.head + 1) % PAGE_MANAGER_NAV_QUEUE_SIZE;
+        self->nav_queue.count--;
+    }
+}
+
+#else
+
+bool nav_queue_post(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, uint16_t n)
+{
+    (void)self;
+    (void)type;
+    (void)id;
+    (void)n;
+    return false;
+}
+
+bool nav_queue_post_push(page_manager_t *self, pm_nav_type_t type, pm_page_id_t id, const pm_nav_stash_t *stash)
+{
+    (void)self;
+    (void)type;
+    (void)id;
+    (void)stash;
+    return false;
+}
+
+void nav_queue_drain(page_manager_t *self)
+{
+    (void)self;
+}
+
+bool nav_queue_is_empty(page_manager_t *self)
+{
+    (void)self;
+    return true;
+}
+
+void nav_queue_clear(page_manager_t *self)
+{
+    (void)self;
+}
+
+#endif
@@ -1,8 +1,22 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_ROUTER
+
 #include "page_manager_private.h"
 
 static bool _switch_anim_state_check(page_manager_t *self);
+static bool _switch_ready(page_manager_t *self, page_base_t *target, bool is_push);
+static page_base_t *_stack_peek(page_manager_t *self, uint16_t n);
+static bool _switch_anim_complete(page_base_t *base);
 static void _switch_anim_type_update(page_manager_t *self, page_base_t *base);
 static void _page_switch(page_manager_t *self, page_base_t *new_node, bool is_push_act, const page_stash_t *stash);
+static void _page_pop_unload(page_base_t *base);
+static page_base_t *_push_target_get(page_manager_t *self, pm_page_id_t id, bool *is_valid);
+static void _nav_stash_copy(pm_nav_stash_t *pending, const page_stash_t *stash);
+static void _page_push(page_manager_t *self, page_base_t *base, const page_stash_t *stash);
+static void _page_move_foreground(page_base_t *base);
+static void _page_order(page_base_t *lower, page_base_t *upper);
+static bool _page_is_opaque(page_manager_t *self, page_base_t *base);
+static lv_obj_t *_switch_anim_var(page_base_t *base);
+static void _switch_snapshot_release(const page_load_anim_attr_t *anim_attr, page_base_t *base);
 
 /**
  * @brief 推送已安装的页面显示
@@ -13,38 +27,241 @@ static void _page_switch(page_manager_t *self, page_base_t *new_node, bool is_pu
  */
 void pm_push(page_manager_t *self, const char *name, const page_stash_t *stash)
 {
-    // 检查是否正在执行切换页面的动画
-    if (!_switch_anim_state_check(self))
+    pm_page_id_t id = pm_get_page_id(self, name);
+    if (id == PM_PAGE_ID_INVALID)
     {
-        PM_LOG_WARN("Page stack anim, cat't pop");
+        PM_LOG_ERROR("Page(%s) was not install", name);
         return;
     }
+    pm_push_id(self, id, stash);
+}
 
-    // 检测是否处于栈区
-    if (find_page_stack(self, name) != NULL)
+/**
+ * @brief 通过页面句柄推送已安装的页面显示
+ *
+ * @param self 页面管理器
+ * @param id 页面句柄
+ * @param stash push时用户的自定义参数
+ */
+void pm_push_id(page_manager_t *self, pm_page_id_t id, const page_stash_t *stash)
+{
+    bool is_valid;
+    page_base_t *base = _push_target_get(self, id, &is_valid);
+    if (base == NULL)
+    {
+        return;
+    }
+
+    // 页面正在切换时放入导航队列,数据块由请求保存,执行时再交给页面
+    if (!_switch_ready(self, is_valid ? base : NULL, true))
     {
-        PM_LOG_ERROR("Page(%s) was multi push", name);
+        pm_nav_stash_t pending;
+        _nav_stash_copy(&pending, stash);
+        nav_queue_post_push(self, PM_NAV_PUSH, id, &pending);
         return;
     }
 
+    if (!is_valid)
+    {
+        return;
+    }
+    _page_push(self, base, stash);
+}
+
+/**
+ * @brief 推送页面并把数据块的所有权转交给页面管理器,不复制数据
+ *
+ * @param self 页面管理器
+ * @param name 页面名
+ * @param ptr 数据块地址
+ * @param size 数据块大小
+ * @param free_cb 页面不再需要数据块时调用,可为NULL
+ * @return true 推送成功,数据块归页面管理器所有
+ * @return false 推送失败,数据块仍归调用者所有
+ */
+bool pm_push_move(page_manager_t *self, const char *name, void *ptr, uint32_t size, page_stash_free_cb_t free_cb)
+{
+    bool is_valid;
+    page_base_t *base = _push_target_get(self, pm_get_page_id(self, name), &is_valid);
+    if (base == NULL)
+    {
+        return false;
+    }
+
+    if (!_switch_ready(self, is_valid ? base : NULL, true))
+    {
+        pm_nav_stash_t pending;
+        pending.type = PAGE_STASH_MOVED;
+        pending.stash.ptr = ptr;
+        pending.stash.size = size;
+        pending.owner.free_cb = free_cb;
+        return nav_queue_post_push(self, PM_NAV_PUSH, base->id, &pending);
+    }
+
+    if (!is_valid)
+    {
+        return false;
+    }
+    stash_move(base, ptr, size, free_cb);
+    _page_push(self, base, NULL);
+    return true;
+}
+
+/**
+ * @brief 推送页面并引用共享数据块,不复制数据
+ *
+ * @param self 页面管理器
+ * @param name 页面名
+ * @param buf 共享数据块,页面持有期间会增加一次引用
+ * @return true 推送成功
+ * @return false 推送失败
+ */
+bool pm_push_shared(page_manager_t *self, const char *name, pm_shared_buf_t *buf)
+{
+    bool is_valid;
+    page_base_t *base = _push_target_get(self, pm_get_page_id(self, name), &is_valid);
+    if (base == NULL)
+    {
+        return false;
+    }
+
+    if (!_switch_ready(self, is_valid ? base : NULL, true))
+    {
+        pm_nav_stash_t pending;
+        pending.type = PAGE_STASH_SHARED;
+        pending.stash.ptr = pm_shared_buf_data(buf);
+        pending.stash.size = buf->size;
+        pending.owner.shared = buf;
+        return nav_queue_post_push(self, PM_NAV_PUSH, base->id, &pending);
+    }
+
+    if (!is_valid)
+    {
+        return false;
+    }
+    stash_share(base, buf);
+    _page_push(self, base, NULL);
+    return true;
+}
+
+/**
+ * @brief 检查页面是否可以被推送
+ *  @note 页面已在栈中时,排队的请求执行后它可能已经出栈,所以队列不为空时仍返回页面对象,
+ *        由请求执行时再检查
+ *
+ * @param self 页面管理器
+ * @param id 页面句柄
+ * @param is_valid 输出,页面是否可以立即推送
+ * @return page_base_t* 页面对象,请求无效且不能放入队列时返回NULL
+ */
+static page_base_t *_push_target_get(page_manager_t *self, pm_page_id_t id, bool *is_valid)
+{
+    *is_valid = false;
+
     // 检测页面是否在页面池中被注册
-    page_base_t *base = find_page_pool(self, name);
+    page_base_t *base = find_page_id(self, id);
     if (base == NULL)
     {
-        PM_LOG_ERROR("Page(%s) was not install", name);
-        return;
+        PM_LOG_ERROR("Page id(0x%x) was not install", (unsigned int)id);
+        return NULL;
     }
 
+    // 检测是否处于栈区
+    if (PAGE_HOT_IS_IN_STACK(base))
+    {
+        if (nav_queue_is_empty(self))
+        {
+            PM_LOG_ERROR("Page(%s) was multi push", base->name);
+            return NULL;
+        }
+        PM_LOG_INFO("Page(%s) is in page stack, checked again after queued requests", base->name);
+        return base;
+    }
+
+    *is_valid = true;
+    return base;
+}
+
+/**
+ * @brief 准备排队请求要复制的数据块,入队时复制
+ *
+ * @param pending 请求携带的数据块
+ * @param stash push时用户的自定义参数,可为NULL
+ */
+static void _nav_stash_copy(pm_nav_stash_t *pending, const page_stash_t *stash)
+{
+    pending->type = PAGE_STASH_NONE;
+    if (stash != NULL)
+    {
+        pending->type = PAGE_STASH_HEAP;
+        pending->stash = *stash;
+    }
+}
+
+/**
+ * @brief 页面压栈并切换
+ *
+ * @param self 页面管理器
+ * @param base 页面对象
+ * @param stash push时用户的自定义参数
+ */
+static void _page_push(page_manager_t *self, page_base_t *base, const page_stash_t *stash)
+{
     /* 同步自动缓存配置*/
     base->priv.is_disable_auto_cache = base->priv.req_disable_auto_cache;
 
     /* 页面压栈 */
-    listAddNodeHead(self->page_stack, base);
+    stack_push(self, base);
 
     /* 切换页面 */
     _page_switch(self, base, true, stash);
 }
 
+/**
+ * @brief 用页面替换栈顶页面
+ *
+ * @param self 页面管理器对象
+ * @param name 页面名称
+ * @param stash push时用户的自定义参数
+ * @return true 替换成功或已放入导航队列
+ * @return false 替换失败
+ */
+bool pm_replace(page_manager_t *self, const char *name, const page_stash_t *stash)
+{
+    bool is_valid;
+    page_base_t *base = _push_target_get(self, pm_get_page_id(self, name), &is_valid);
+    if (base == NULL)
+    {
+        return false;
+    }
+
+    if (!_switch_ready(self, is_valid ? base : NULL, true))
+    {
+        pm_nav_stash_t pending;
+        _nav_stash_copy(&pending, stash);
+        return nav_queue_post_push(self, PM_NAV_REPLACE, base->id, &pending);
+    }
+
+    if (!is_valid)
+    {
+        return false;
+    }
+
+    /* 原栈顶页面出栈,由后面的切换播放退出动画 */
+    page_base_t *top = stack_pop(self);
+    if (top != NULL)
+    {
+        if (!top->priv.is_disable_auto_cache)
+        {
+            PAGE_HOT_IS_CACHED(top) = false;
+        }
+        PM_LOG_INFO("Page(%s) replaced by Page(%s)", top->name, base->name);
+    }
+
+    _page_push(self, base, stash);
+    return true;
+}
+
 /**
  * @brief 回退到上一个页面
  *
@@ -52,10 +269,18 @@ void pm_push(page_manager_t *self, const char *name, const page_stash_t *stash)
  */
 void pm_pop(page_manager_t *self)
 {
-    // 检查是否正在执行切换页面的动画
-    if (!_switch_anim_state_check(self))
+    // 栈中不足两个页面时没有可回退的页面,除非排队的push执行后会入栈新页面
+    page_base_t *target = self->stack_depth >= 2 ? _stack_peek(self, 1) : NULL;
+    if (target == NULL && nav_queue_is_empty(self))
+    {
+        PM_LOG_WARN("Page stack has no page to pop");
+        return;
+    }
+
+    // 页面正在切换时放入导航队列
+    if (!_switch_ready(self, target, false))
     {
-        PM_LOG_WARN("Page stack anim, cat't pop");
+        nav_queue_post(self, PM_NAV_POP, PM_PAGE_ID_INVALID, 1);
         return;
     }
 
@@ -68,16 +293,23 @@ void pm_pop(page_manager_t *self)
         return;
     }
 
+    // 栈底页面正在显示,出栈后页面会脱离页面栈且无法再被卸载
+    if (top->priv.stack_next == NULL)
+    {
+        PM_LOG_WARN("Page(%s) is the last page, cat't pop", top->name);
+        return;
+    }
+
     if (!top->priv.is_disable_auto_cache)
     {
         PM_LOG_INFO("Page(%s) has auto cache, cache disabled", top->name);
-        top->priv.is_cached = false;
+        PAGE_HOT_IS_CACHED(top) = false;
     }
 
     PM_LOG_INFO("Page(%s) pop << [Screen]", top->name);
 
     // 页面出栈
-    listDelNode(self->page_stack, listSearchKey(self->page_stack, top));
+    stack_pop(self);
 
     top = get_stack_top(self);
 
@@ -92,6 +324,149 @@ void pm_pop(page_manager_t *self)
     }
 }
 
+/**
+ * @brief 一次回退多层页面
+ *
+ * @param self 页面管理器对象
+ * @param n 回退的层数,超过栈深度时回退到栈底页面
+ * @return true 回退成功或已放入导航队列
+ * @return false 导航队列已满或没有可回退的页面
+ */
+bool pm_pop_n(page_manager_t *self, uint16_t n)
+{
+    // 栈中不足两个页面时没有可回退的页面,除非排队的push执行后会入栈新页面
+    if (n == 0 || (self->stack_depth < 2 && nav_queue_is_empty(self)))
+    {
+        PM_LOG_WARN("Page stack has no page to pop");
+        return false;
+    }
+
+    // 页面正在切换时放入导航队列
+    if (!_switch_ready(self, self->stack_depth >= 2 ? _stack_peek(self, n) : NULL, false))
+    {
+        return nav_queue_post(self, PM_NAV_POP, PM_PAGE_ID_INVALID, n);
+    }
+
+    if (self->stack_depth < 2)
+    {
+        PM_LOG_WARN("Page stack has no page to pop");
+        return false;
+    }
+
+    if (n > self->stack_depth - 1)
+    {
+        n = self->stack_depth - 1;
+    }
+
+    /* 栈顶页面出栈,由后面的切换播放退出动画 */
+    page_base_t *top = stack_pop(self);
+    if (!top->priv.is_disable_auto_cache)
+    {
+        PM_LOG_INFO("Page(%s) has auto cache, cache disabled", top->name);
+        PAGE_HOT_IS_CACHED(top) = false;
+    }
+    PM_LOG_INFO("Page(%s) pop << [Screen]", top->name);
+
+    /* 中间页面直接出栈卸载,不播放动画 */
+    while (--n > 0)
+    {
+        _page_pop_unload(stack_pop(self));
+    }
+
+    /* 从原栈顶直接切换到目标页面 */
+    _page_switch(self, get_stack_top(self), false, NULL);
+    return true;
+}
+
+/**
+ * @brief 回退到指定页面
+ *
+ * @param self 页面管理器对象
+ * @param name 目标页面名称,必须在页面栈中
+ * @return true 回退成功或已放入导航队列
+ * @return false 导航队列已满或目标页面不在页面栈中
+ */
+bool pm_pop_to(page_manager_t *self, const char *name)
+{
+    pm_page_id_t id = pm_get_page_id(self, name);
+    if (id == PM_PAGE_ID_INVALID)
+    {
+        PM_LOG_ERROR("Page(%s) was not install", name);
+        return false;
+    }
+    return pm_pop_to_id(self, id);
+}
+
+/**
+ * @brief 通过页面句柄回退到指定页面
+ *
+ * @param self 页面管理器对象
+ * @param id 目标页面句柄,必须在页面栈中
+ * @return true 回退成功或已放入导航队列
+ * @return false 导航队列已满或目标页面不在页面栈中
+ */
+bool pm_pop_to_id(page_manager_t *self, pm_page_id_t id)
+{
+    page_base_t *target = find_page_id(self, id);
+    if (target == NULL)
+    {
+        PM_LOG_ERROR("Page id(0x%x) was not install", (unsigned int)id);
+        return false;
+    }
+
+    // 排队的请求执行后目标页面可能已经入栈,此时在执行时再检查
+    bool is_valid = PAGE_HOT_IS_IN_STACK(target);
+    if (!is_valid && nav_queue_is_empty(self))
+    {
+        PM_LOG_ERROR("Page id(0x%x) was not in page stack", (unsigned int)id);
+        return false;
+    }
+
+    // 页面正在切换时放入导航队列
+    if (!_switch_ready(self, is_valid ? target : NULL, false))
+    {
+        return nav_queue_post(self, PM_NAV_POP_TO, id, 0);
+    }
+
+    if (!is_valid)
+    {
+        PM_LOG_ERROR("Page id(0x%x) was not in page stack", (unsigned int)id);
+        return false;
+    }
+
+    uint16_t n = 0;
+    for (page_base_t *base = self->stack_top; base != target; base = base->priv.stack_next)
+    {
+        n++;
+    }
+
+    if (n == 0)
+    {
+        PM_LOG_INFO("Page(%s) is already on the top", target->name);
+        return true;
+    }
+    return pm_pop_n(self, n);
+}
+
+/**
+ * @brief 卸载被批量回退跳过的页面
+ *
+ * @param base 页面对象
+ */
+static void _page_pop_unload(page_base_t *base)
+{
+    if (!base->priv.is_disable_auto_cache)
+    {
+        PAGE_HOT_IS_CACHED(base) = false;
+    }
+
+    if (!PAGE_HOT_IS_CACHED(base))
+    {
+        PM_LOG_INFO("Page(%s) skipped by pop, unloading...", base->name);
+        fource_unload(base);
+    }
+}
+
 /**
  * @brief 切换页面
  *
@@ -115,55 +490,28 @@ static void _page_switch(page_manager_t *self, page_base_t *new_node, bool is_pu
     }
 
     self->anim_state.is_switch_req = true; // 请求切换页面
+    stats_input(self, new_node);
+    page_anim_attr_update(self);
 
     if (stash != NULL) // 如果有缓存区
     {
         PM_LOG_INFO("stash is detect, %s >> stash(%p) >> %s", get_page_prev_name(self), stash, new_node->name);
 
-        void *buffer = NULL;
-
-        //如果缓存区是空则申请内存
-        if (new_node->priv.stash.ptr == NULL)
-        {
-            buffer = PM_MALLOC(stash->size);
-            if (buffer == NULL)
-            {
-                PM_LOG_ERROR("stash malloc failed");
-            }
-            else
-            {
-                PM_LOG_INFO("stash(%p) malloc[%d]", buffer, stash->size);
-            }
-        }
-        // 如果缓存区大小和现在大小一致。则获取内存地址（为下文营造非空判断）
-        else if (new_node->priv.stash.size == stash->size)
-        {
-            buffer = new_node->priv.stash.ptr;
-            PM_LOG_INFO("stash(%p) is exist", buffer);
-        }
-
-        // 将当前缓存的地址内容复制到缓存
-        if (buffer != NULL)
-        {
-            memcpy(buffer, stash->ptr, stash->size);
-            PM_LOG_INFO("stash memcpy[%d] %p >> %p", stash->size, stash->ptr, buffer);
-            new_node->priv.stash.ptr = buffer;
-            new_node->priv.stash.size = stash->size;
-        }
+        stash_store(new_node, stash);
     }
 
     // 当前页面更新
     self->page_current = new_node;
 
     // 如果页面有被缓存则跳过PAGE_STATE_LOAD
-    if (self->page_current->priv.is_cached)
+    if (PAGE_HOT_IS_CACHED(self->page_current))
     {
         PM_LOG_INFO("Page(%s) has cached, appear driectly", self->page_current->name);
-        self->page_current->priv.state = PAGE_STATE_WILL_APPEAR;
+        PAGE_HOT_STATE(self->page_current) = PAGE_STATE_WILL_APPEAR;
     }
     else
     {
-        self->page_current->priv.state = PAGE_STATE_LOAD;
+        PAGE_HOT_STATE(self->page_current) = PAGE_STATE_LOAD;
     }
 
     // 如果上一个页面存在则将is_enter标志位置0
@@ -184,6 +532,10 @@ static void _page_switch(page_manager_t *self, page_base_t *new_node, bool is_pu
         _switch_anim_type_update(self, self->page_current);
     }
 
+    // 被遮挡隐藏的页面在切换动画开始前显示
+    page_reveal(self->page_prev);
+    page_reveal(self->page_current);
+
     // 更新页面
     page_state_update(self, self->page_prev);
     page_state_update(self, self->page_current);
@@ -192,16 +544,140 @@ static void _page_switch(page_manager_t *self, page_base_t *new_node, bool is_pu
     if (self->anim_state.is_pushing)
     {
         PM_LOG_INFO("Page PUSH is detect, move Page(%s) to foreground", self->page_current->name);
-        if (self->page_prev)
-            lv_obj_move_foreground(self->page_prev->root);
-        lv_obj_move_foreground(self->page_current->root);
+        _page_order(self->page_prev, self->page_current);
     }
     else
     {
         PM_LOG_INFO("Page POP is detect, move Page(%s) to foreground", get_page_prev_name(self));
-        lv_obj_move_foreground(self->page_current->root);
-        if (self->page_prev)
-            lv_obj_move_foreground(self->page_prev->root);
+        _page_order(self->page_current, self->page_prev);
+    }
+}
+
+/**
+ * @brief 将页面根对象和快照移到前台
+ *
+ * @param base 页面对象
+ */
+static void _page_move_foreground(page_base_t *base)
+{
+    lv_obj_move_foreground(base->root);
+    if (base->priv.anim.snapshot != NULL)
+    {
+        lv_obj_move_foreground(base->priv.anim.snapshot);
+    }
+}
+
+/**
+ * @brief 调整两个页面的前后关系,upper在最前,lower紧贴在它下面
+ *  @note lv_obj_move_foreground会使整个根对象区域重绘,前后关系已经正确时跳过
+ *
+ * @param lower 下层页面,可为NULL
+ * @param upper 上层页面
+ */
+static void _page_order(page_base_t *lower, page_base_t *upper)
+{
+    if (lower == upper)
+    {
+        lower = NULL;
+    }
+
+    bool has_snapshot = upper->priv.anim.snapshot != NULL || (lower != NULL && lower->priv.anim.snapshot != NULL);
+    if (!has_snapshot)
+    {
+        lv_obj_t *parent = lv_obj_get_parent(upper->root);
+        if (lv_obj_get_child(parent, NULL) == upper->root &&
+            (lower == NULL || lv_obj_get_child(parent, upper->root) == lower->root))
+        {
+            PM_LOG_INFO("Page z-order unchanged");
+            return;
+        }
+    }
+
+    if (lower != NULL)
+    {
+        _page_move_foreground(lower);
+    }
+    _page_move_foreground(upper);
+}
+
+/**
+ * @brief 显示被遮挡隐藏的页面
+ *
+ * @param base 页面对象,可为NULL
+ */
+void page_reveal(page_base_t *base)
+{
+    if (base == NULL || !base->priv.is_occluded)
+    {
+        return;
+    }
+
+    base->priv.is_occluded = false;
+    if (base->root != NULL)
+    {
+        lv_obj_set_hidden(base->root, false);
+        PM_LOG_INFO("Page(%s) revealed", base->name);
+    }
+}
+
+/**
+ * @brief 检测页面是否完全遮挡整个显示区域
+ *  @note 没有声明不透明时,根对象背景和opa_scale都必须完全不透明,且尺寸覆盖整个显示区域
+ *
+ * @param self 页面管理器对象
+ * @param base 页面对象
+ * @return true 页面不透明
+ * @return false 下层页面可能透过页面显示
+ */
+static bool _page_is_opaque(page_manager_t *self, page_base_t *base)
+{
+    if (base->priv.is_opaque)
+    {
+        return true;
+    }
+
+    lv_coord_t hor, ver;
+    get_resolution(self, &hor, &ver);
+    return lv_obj_get_style_bg_opa(base->root, LV_OBJ_PART_MAIN) == LV_OPA_COVER &&
+           lv_obj_get_style_opa_scale(base->root, LV_OBJ_PART_MAIN) == LV_OPA_COVER &&
+           lv_obj_get_width(base->root) >= hor && lv_obj_get_height(base->root) >= ver;
+}
+
+/**
+ * @brief 隐藏被当前页面完全遮挡的栈中页面根对象
+ *  @note 隐藏的根对象不参与绘制、重绘区域计算和点击检测;
+ *        当前页面没有回到原点(如拖拽中)或不透明时不隐藏
+ *
+ * @param self 页面管理器对象
+ */
+void page_occlusion_update(page_manager_t *self)
+{
+    page_base_t *current = self->page_current;
+    if (current == NULL || current->root == NULL || lv_obj_get_hidden(current->root) ||
+        lv_obj_get_x(current->root) != 0 || lv_obj_get_y(current->root) != 0 ||
+        !_page_is_opaque(self, current))
+    {
+        return;
+    }
+
+    // 动画结束后没有覆盖整个显示区域的页面不遮挡下层页面
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(self);
+    if (anim_attr != NULL && anim_attr->is_partial)
+    {
+        return;
+    }
+
+    // 只有栈中的页面会留在当前页面之下,出栈的页面动画结束后由page_anim_release处理
+    for (page_base_t *base = self->stack_top; base != NULL; base = base->priv.stack_next)
+    {
+        if (base == current || base->root == NULL || base->priv.anim.snapshot != NULL || lv_obj_get_hidden(base->root))
+        {
+            continue;
+        }
+
+        base->priv.is_occluded = true;
+        lv_obj_set_hidden(base->root, true);
+        PM_LOG_INFO("Page(%s) occluded, hidden", base->name);
     }
 }
 
@@ -222,14 +698,14 @@ bool fource_unload(page_base_t *base)
 
     PM_LOG_INFO("Page(%s) Fource unloading...", base->name);
 
-    if (base->priv.state == PAGE_STATE_ACTIVITY)
+    if (PAGE_HOT_STATE(base) == PAGE_STATE_ACTIVITY)
     {
         PM_LOG_INFO("Page state is ACTIVITY, Disappearing...");
         base->base->on_view_will_disappear(base);
         base->base->on_view_did_disappear(base);
     }
 
-    base->priv.state = state_unload_execute(base);
+    PAGE_HOT_STATE(base) = state_unload_execute(base);
 
     return true;
 }
@@ -238,21 +714,30 @@ bool fource_unload(page_base_t *base)
  * @brief 返回主界面
  *
  * @param self 页面管理器对象
- * @return true 返回成功
- * @return false 页面正在切换
+ * @return true 返回成功或已放入导航队列
+ * @return false 导航队列已满
  */
 bool pm_back_home(page_manager_t *self)
 {
-    // 检查是否正在执行切换页面的动画
-    if (!_switch_anim_state_check(self))
+    page_base_t *target = self->stack_depth >= 2 ? _stack_peek(self, UINT16_MAX) : NULL;
+    if (target == NULL && nav_queue_is_empty(self))
     {
-        return false;
+        PM_LOG_INFO("Page stack is already at home");
+        return true;
     }
-    set_satck_clear(self, true);
-    self->page_prev = NULL;
-    page_base_t *home = get_stack_top(self);
-    _page_switch(self, home, false, NULL);
-    return true;
+
+    // 页面正在切换时放入导航队列
+    if (!_switch_ready(self, target, false))
+    {
+        return nav_queue_post(self, PM_NAV_HOME, PM_PAGE_ID_INVALID, 0);
+    }
+
+    if (self->stack_depth <= 1)
+    {
+        PM_LOG_INFO("Page stack is already at home");
+        return true;
+    }
+    return pm_pop_n(self, self->stack_depth - 1);
 }
 
 /**
@@ -277,6 +762,106 @@ static bool _switch_anim_state_check(page_manager_t *self)
     return true;
 }
 
+/**
+ * @brief 获取回退n层后的栈顶页面
+ *
+ * @param self 页面管理器对象
+ * @param n 回退层数,超过栈深度时返回栈底页面
+ * @return page_base_t* 页面对象,栈为空时返回NULL
+ */
+static page_base_t *_stack_peek(page_manager_t *self, uint16_t n)
+{
+    page_base_t *base = self->stack_top;
+    while (base != NULL && base->priv.stack_next != NULL && n-- > 0)
+    {
+        base = base->priv.stack_next;
+    }
+    return base;
+}
+
+/**
+ * @brief 打断正在播放的切换动画,立即完成本次切换的状态更新
+ *
+ *  @note 停在当前位置时,退出中的页面只有在被新请求重新显示时才保留位置,否则跳到终点
+ *
+ * @param self 页面管理器对象
+ * @param is_finish true 动画跳到终点; false 根对象停在当前位置,下一次切换从该位置开始
+ * @param target 新请求要显示的页面
+ */
+static void _switch_preempt(page_manager_t *self, bool is_finish, page_base_t *target)
+{
+    // 新页面还在分帧构建,不打断
+    if (self->page_current != NULL && PAGE_HOT_STATE(self->page_current) == PAGE_STATE_LOADING)
+    {
+        return;
+    }
+
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(self);
+    if (anim_attr == NULL)
+    {
+        return;
+    }
+
+    page_base_t *pages[2] = {self->page_prev, self->page_current};
+    for (int i = 0; i < 2; i++)
+    {
+        page_base_t *base = pages[i];
+        if (base == NULL || !PAGE_HOT_IS_BUSY(base) || (i == 1 && base == pages[0]))
+        {
+            continue;
+        }
+
+        bool is_park = !is_finish && (base == self->page_current || base == target);
+        lv_obj_t *var = _switch_anim_var(base);
+        lv_anim_t *a = lv_anim_get(var, anim_attr->setter);
+        if (a != NULL && !is_park && a->exec_cb != NULL)
+        {
+            a->exec_cb(a->var, a->end);
+        }
+        lv_anim_del(var, anim_attr->setter);
+        _switch_snapshot_release(anim_attr, base);
+        if (!is_park)
+        {
+            page_anim_release(base);
+        }
+
+        PM_LOG_INFO("Page(%s) anim %s", base->name, is_park ? "interrupted" : "fast-forward");
+        base->priv.anim.is_interrupted = is_park;
+        _switch_anim_complete(base);
+    }
+}
+
+/**
+ * @brief 检查能否立即切换页面,按打断方式处理正在播放的切换动画
+ *  @note 拖拽回弹期间不打断;调用前先检查请求,无效的请求不打断动画;
+ *        打断后先执行队列中的请求
+ *
+ * @param self 页面管理器对象
+ * @param target 请求要显示的页面,请求不能立即执行时为NULL
+ * @param is_push 是否为push请求,高优先级页面的push总是打断动画
+ * @return true 可以立即切换
+ * @return false 页面正在切换
+ */
+static bool _switch_ready(page_manager_t *self, page_base_t *target, bool is_push)
+{
+    if (self->anim_state.is_switch_req && !self->anim_state.is_busy && target != NULL)
+    {
+        uint8_t preempt = self->anim_state.preempt;
+        if (preempt == PM_PREEMPT_NONE && is_push && target->priv.priority > 0)
+        {
+            preempt = PM_PREEMPT_FINISH;
+        }
+
+        if (preempt != PM_PREEMPT_NONE)
+        {
+            _switch_preempt(self, preempt == PM_PREEMPT_FINISH, target);
+            // 先执行之前排队的请求,排队的请求开始新的切换时本次请求随后入队,保持请求顺序
+            nav_queue_drain(self);
+        }
+    }
+    return _switch_anim_state_check(self);
+}
+
 /**
  * @brief 检测切换动画是否完成
  *
@@ -287,9 +872,9 @@ static bool _switch_anim_state_check(page_manager_t *self)
 static bool _switch_req_check(page_manager_t *self)
 {
     bool ret = false;
-    bool last_node_busy = self->page_prev && self->page_prev->priv.anim.is_busy;
+    bool last_node_busy = self->page_prev && PAGE_HOT_IS_BUSY(self->page_prev);
 
-    if (!self->page_current->priv.anim.is_busy && !last_node_busy)
+    if (!PAGE_HOT_IS_BUSY(self->page_current) && !last_node_busy)
     {
         PM_LOG_INFO("----Page switch was all finished----");
         self->anim_state.is_switch_req = false;
@@ -298,7 +883,7 @@ static bool _switch_req_check(page_manager_t *self)
     }
     else
     {
-        if (self->page_current->priv.anim.is_busy)
+        if (PAGE_HOT_IS_BUSY(self->page_current))
         {
             PM_LOG_WARN("Page PageCurrent(%s) is busy", self->page_current->name);
         }
@@ -318,18 +903,50 @@ static bool _switch_req_check(page_manager_t *self)
 static void _switch_anim_finsh(lv_anim_t *a)
 {
     page_base_t *base = (page_base_t *)a->user_data;
-    page_manager_t *manager = base->manager;
 
     PM_LOG_INFO("Page(%s) Anim finish", base->name);
 
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(base->manager);
+    if (anim_attr != NULL)
+    {
+        _switch_snapshot_release(anim_attr, base);
+    }
+    page_anim_release(base);
+
+    if (_switch_anim_complete(base))
+    {
+        nav_queue_drain(base->manager);
+    }
+}
+
+/**
+ * @brief 页面的切换动画结束或被打断后更新页面状态
+ *
+ * @param base 页面对象
+ * @return true 本次切换的所有动画都已完成
+ * @return false 还有动画在播放
+ */
+static bool _switch_anim_complete(page_base_t *base)
+{
+    page_manager_t *manager = base->manager;
+
+    trace_anim_end(base);
+
     page_state_update(manager, base);
-    base->priv.anim.is_busy = false;
+    PAGE_HOT_IS_BUSY(base) = false;
     bool is_finished = _switch_req_check(manager);
 
     if (!manager->anim_state.is_pushing && is_finished)
     {
         _switch_anim_type_update(manager, manager->page_current);
     }
+    if (is_finished)
+    {
+        state_under_restore(manager);
+        page_occlusion_update(manager);
+        cache_trim(manager);
+    }
+    return is_finished;
 }
 
 /**
@@ -340,9 +957,9 @@ static void _switch_anim_finsh(lv_anim_t *a)
  */
 void switch_anim_create(page_manager_t *self, page_base_t *base)
 {
-    page_load_anim_attr_t anim_attr;
     // 获取当前页面参数
-    if (!page_get_current_load_anim_attr(self, &anim_attr))
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(self);
+    if (anim_attr == NULL)
     {
         return;
     }
@@ -350,16 +967,28 @@ void switch_anim_create(page_manager_t *self, page_base_t *base)
     lv_anim_t a;
     anim_default_init(self, &a);
 
+    // 平移/覆盖类动画使用快照代替根对象移动
+    if (self->snapshot_cb != NULL && anim_attr->drag_dir != ROOT_DRAG_DIR_NONE && base->priv.anim.snapshot == NULL)
+    {
+        lv_obj_t *snapshot = self->snapshot_cb(base);
+        if (snapshot != NULL)
+        {
+            lv_obj_set_pos(snapshot, lv_obj_get_x(base->root), lv_obj_get_y(base->root));
+            lv_obj_set_hidden(base->root, true);
+            base->priv.anim.snapshot = snapshot;
+        }
+    }
+
     a.user_data = base;
-    lv_anim_set_var(&a, base->root);
+    lv_anim_set_var(&a, _switch_anim_var(base));
     lv_anim_set_ready_cb(&a, _switch_anim_finsh);
-    lv_anim_set_exec_cb(&a, anim_attr.setter);
+    lv_anim_set_exec_cb(&a, anim_attr->setter);
 
     int32_t start = 0;
 
-    if (anim_attr.getter)
+    if (anim_attr->getter)
     {
-        start = anim_attr.getter(base->root);
+        start = anim_attr->getter(base->root);
     }
 
     // 根据标志位更新动画
@@ -369,15 +998,15 @@ void switch_anim_create(page_manager_t *self, page_base_t *base)
         {
             lv_anim_set_values(
                 &a,
-                anim_attr.push.enter.start,
-                anim_attr.push.enter.end);
+                anim_attr->push.enter.start,
+                anim_attr->push.enter.end);
         }
         else /* Exit */
         {
             lv_anim_set_values(
                 &a,
                 start,
-                anim_attr.push.exit.end);
+                anim_attr->push.exit.end);
         }
     }
     else /* Pop */
@@ -386,20 +1015,91 @@ void switch_anim_create(page_manager_t *self, page_base_t *base)
         {
             lv_anim_set_values(
                 &a,
-                anim_attr.pop.enter.start,
-                anim_attr.pop.enter.end);
+                anim_attr->pop.enter.start,
+                anim_attr->pop.enter.end);
         }
         else /* Exit */
         {
             lv_anim_set_values(
                 &a,
                 start,
-                anim_attr.pop.exit.end);
+                anim_attr->pop.exit.end);
         }
     }
 
+    // 被打断的页面从当前位置继续,动画时间按剩余距离缩短
+    if (base->priv.anim.is_interrupted && anim_attr->getter)
+    {
+        int32_t full = abs(anim_attr->push.enter.end - anim_attr->push.enter.start);
+        int32_t remain = abs(a.end - start);
+        lv_anim_set_values(&a, start, a.end);
+        if (remain < full)
+        {
+            a.time = a.time * remain / full;
+        }
+    }
+    base->priv.anim.is_interrupted = false;
+
+    trace_anim_begin(base);
     lv_anim_start(&a);
-    base->priv.anim.is_busy = true;
+    PAGE_HOT_IS_BUSY(base) = true;
+}
+
+/**
+ * @brief 设置切换动画播放期间收到新的导航请求时的处理方式
+ *
+ * @param self 页面管理器对象
+ * @param preempt 处理方式
+ */
+void pm_set_preempt_mode(page_manager_t *self, pm_preempt_t preempt)
+{
+    self->anim_state.preempt = (uint8_t)preempt;
+    PM_LOG_INFO("Set preempt mode = %d", preempt);
+}
+
+/**
+ * @brief 设置页面快照回调
+ *
+ * @param self 页面管理器对象
+ * @param snapshot_cb 快照回调,NULL 关闭
+ */
+void pm_set_snapshot_cb(page_manager_t *self, pm_snapshot_cb_t snapshot_cb)
+{
+    self->snapshot_cb = snapshot_cb;
+}
+
+/**
+ * @brief 获取切换动画作用的对象
+ *
+ * @param base 页面对象
+ * @return lv_obj_t* 有快照时返回快照,否则返回根对象
+ */
+static lv_obj_t *_switch_anim_var(page_base_t *base)
+{
+    return base->priv.anim.snapshot != NULL ? base->priv.anim.snapshot : base->root;
+}
+
+/**
+ * @brief 根对象移动到快照的位置后显示,删除快照
+ *
+ * @param anim_attr 当前动画属性
+ * @param base 页面对象
+ */
+static void _switch_snapshot_release(const page_load_anim_attr_t *anim_attr, page_base_t *base)
+{
+    lv_obj_t *snapshot = base->priv.anim.snapshot;
+    if (snapshot == NULL)
+    {
+        return;
+    }
+
+    base->priv.anim.snapshot = NULL;
+    if (anim_attr->setter != NULL && anim_attr->getter != NULL)
+    {
+        anim_attr->setter(base->root, anim_attr->getter(snapshot));
+    }
+    lv_obj_set_hidden(base->root, false);
+    lv_obj_del(snapshot);
 }
 
 /**
@@ -410,9 +1110,9 @@ void switch_anim_create(page_manager_t *self, page_base_t *base)
  * @param time 动画持续时间
  * @param path 动画路径
  */
-void pm_set_global_load_anim_type(page_manager_t *self, page_load_anim_t anim, uint16_t time, lv_anim_path_cb_t path)
+void pm_set_global_load_anim_type(page_manager_t *self, uint8_t anim, uint16_t time, lv_anim_path_cb_t path)
 {
-    if (anim > _LOAD_ANIM_LAST)
+    if (!page_anim_type_is_valid(self, anim))
     {
         anim = LOAD_ANIM_NONE;
     }
@@ -442,7 +1142,7 @@ void _switch_anim_type_update(page_manager_t *self, page_base_t *base)
     }
     else
     {
-        if (base->priv.anim.attr.type > _LOAD_ANIM_LAST)
+        if (!page_anim_type_is_valid(self, base->priv.anim.attr.type))
         {
             PM_LOG_ERROR("Page(%s)", base->name);
             PM_LOG_ERROR("ERROR custom Anim.Type = %d", base->priv.anim.attr.type);
@@ -0,0 +1,296 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_STASH
+
+#include "page_manager_private.h"
+
+/**
+ * @brief 获取数据块大小对应的内存池分级
+ *
+ * @param size 数据块大小
+ * @return int 内存池分级,超过最大分级返回-1
+ */
+static int _stash_pool_class(uint32_t size)
+{
+    for (int i = 0; i < PAGE_MANAGER_STASH_POOL_CLASSES; i++)
+    {
+        if (size <= STASH_POOL_CLASS_SIZE(i))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 获取页面当前数据块存储区的容量
+ *
+ * @param base 页面对象
+ * @return uint32_t 容量,没有存储区时返回0
+ */
+static uint32_t _stash_capacity(page_base_t *base)
+{
+    switch (base->priv.stash_type)
+    {
+    case PAGE_STASH_INLINE:
+        return PAGE_MANAGER_STASH_INLINE_SIZE;
+    case PAGE_STASH_POOL:
+        return STASH_POOL_CLASS_SIZE(base->priv.stash_class);
+    case PAGE_STASH_HEAP:
+        return base->priv.stash.size;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief 为页面申请能放下size字节的数据块存储区
+ *
+ * @param base 页面对象
+ * @param size 数据块大小
+ * @return void* 存储区地址,失败返回NULL
+ */
+static void *_stash_acquire(page_base_t *base, uint32_t size)
+{
+    page_manager_t *manager = base->manager;
+
+    if (size <= PAGE_MANAGER_STASH_INLINE_SIZE)
+    {
+        base->priv.stash_type = PAGE_STASH_INLINE;
+        return base->priv.stash_inline.buf;
+    }
+
+    int cls = _stash_pool_class(size);
+    if (cls < 0)
+    {
+        void *buffer = pm_mem_alloc(manager, size);
+        if (buffer != NULL)
+        {
+            base->priv.stash_type = PAGE_STASH_HEAP;
+        }
+        return buffer;
+    }
+
+    void *buffer = manager->stash_pool[cls];
+    if (buffer != NULL)
+    {
+        manager->stash_pool[cls] = *(void **)buffer;
+    }
+    else
+    {
+        buffer = pm_mem_alloc(manager, STASH_POOL_CLASS_SIZE(cls));
+        if (buffer == NULL)
+        {
+            return NULL;
+        }
+        PM_LOG_INFO("stash pool class[%d] grow(%p)", cls, buffer);
+    }
+    base->priv.stash_type = PAGE_STASH_POOL;
+    base->priv.stash_class = (uint8_t)cls;
+    return buffer;
+}
+
+/**
+ * @brief 保存push时传入的数据块
+ *  @note 现有存储区放得下时直接复用,否则归还后重新申请
+ *
+ * @param base 页面对象
+ * @param stash 数据块
+ * @return true 保存成功
+ * @return false 保存失败,页面不再持有数据块
+ */
+bool stash_store(page_base_t *base, const page_stash_t *stash)
+{
+    void *buffer = base->priv.stash.ptr;
+
+    /* 直接申请的存储区按实际大小记账,大小变化时不复用,避免释放时记账不一致 */
+    if (buffer == NULL || stash->size > _stash_capacity(base) ||
+        (base->priv.stash_type == PAGE_STASH_HEAP && stash->size != base->priv.stash.size))
+    {
+        stash_release(base);
+        buffer = _stash_acquire(base, stash->size);
+        if (buffer == NULL)
+        {
+            PM_LOG_ERROR("stash malloc failed");
+            return false;
+        }
+    }
+
+    if (stash->size > 0)
+    {
+        memcpy(buffer, stash->ptr, stash->size);
+    }
+    PM_LOG_INFO("stash memcpy[%d] %p >> %p", stash->size, stash->ptr, buffer);
+    base->priv.stash.ptr = buffer;
+    base->priv.stash.size = stash->size;
+    return true;
+}
+
+/**
+ * @brief 释放页面持有的数据块,内存池中的存储区归还给内存池
+ *
+ * @param base 页面对象
+ */
+void stash_release(page_base_t *base)
+{
+    page_manager_t *manager = base->manager;
+    void *buffer = base->priv.stash.ptr;
+
+    switch (base->priv.stash_type)
+    {
+    case PAGE_STASH_POOL:
+        *(void **)buffer = manager->stash_pool[base->priv.stash_class];
+        manager->stash_pool[base->priv.stash_class] = buffer;
+        break;
+    case PAGE_STASH_HEAP:
+        pm_mem_free(manager, buffer, base->priv.stash.size);
+        break;
+    case PAGE_STASH_MOVED:
+        if (base->priv.stash_owner.free_cb != NULL)
+        {
+            base->priv.stash_owner.free_cb(buffer);
+        }
+        break;
+    case PAGE_STASH_SHARED:
+        pm_shared_buf_release(base->priv.stash_owner.shared);
+        break;
+    default:
+        break;
+    }
+
+    base->priv.stash_type = PAGE_STASH_NONE;
+    base->priv.stash.ptr = NULL;
+    base->priv.stash.size = 0;
+}
+
+/**
+ * @brief 接管调用者的数据块,不复制数据
+ *
+ * @param base 页面对象
+ * @param ptr 数据块地址
+ * @param size 数据块大小
+ * @param free_cb 释放数据块的回调
+ */
+void stash_move(page_base_t *base, void *ptr, uint32_t size, page_stash_free_cb_t free_cb)
+{
+    stash_release(base);
+    base->priv.stash_type = PAGE_STASH_MOVED;
+    base->priv.stash_owner.free_cb = free_cb;
+    base->priv.stash.ptr = ptr;
+    base->priv.stash.size = size;
+    PM_LOG_INFO("stash(%p)[%d] moved to Page(%s)", ptr, size, base->name);
+}
+
+/**
+ * @brief 引用共享数据块,不复制数据
+ *
+ * @param base 页面对象
+ * @param buf 共享数据块
+ */
+void stash_share(page_base_t *base, pm_shared_buf_t *buf)
+{
+    /* 先增加引用,避免页面已持有同一数据块时被提前释放 */
+    pm_shared_buf_retain(buf);
+    stash_release(base);
+    base->priv.stash_type = PAGE_STASH_SHARED;
+    base->priv.stash_owner.shared = buf;
+    base->priv.stash.ptr = pm_shared_buf_data(buf);
+    base->priv.stash.size = buf->size;
+    PM_LOG_INFO("stash shared(%p)[%d] ref = %d >> Page(%s)", buf, buf->size, buf->ref, base->name);
+}
+
+/**
+ * @brief 创建共享数据块,引用计数为1
+ *
+ * @param self 页面管理器对象
+ * @param size 数据大小
+ * @return pm_shared_buf_t* 共享数据块,失败返回NULL
+ */
+pm_shared_buf_t *pm_shared_buf_create(page_manager_t *self, uint32_t size)
+{
+    pm_shared_buf_t *buf = (pm_shared_buf_t *)pm_mem_alloc(self, sizeof(pm_shared_buf_t) + size);
+    if (buf == NULL)
+    {
+        return NULL;
+    }
+    buf->manager = self;
+    buf->ref = 1;
+    buf->size = size;
+    self->shared_buf_count++;
+    return buf;
+}
+
+/**
+ * @brief 获取共享数据块的数据地址
+ *
+ * @param buf 共享数据块
+ * @return void* 数据地址
+ */
+void *pm_shared_buf_data(pm_shared_buf_t *buf)
+{
+    return buf->data;
+}
+
+/**
+ * @brief 增加共享数据块的引用
+ *
+ * @param buf 共享数据块
+ */
+void pm_shared_buf_retain(pm_shared_buf_t *buf)
+{
+    buf->ref++;
+}
+
+/**
+ * @brief 减少共享数据块的引用,引用归零时释放
+ *
+ * @param buf 共享数据块
+ */
+void pm_shared_buf_release(pm_shared_buf_t *buf)
+{
+    if (buf == NULL)
+    {
+        return;
+    }
+    if (--buf->ref == 0)
+    {
+        PM_LOG_INFO("stash shared(%p)[%d] free", buf, buf->size);
+        buf->manager->shared_buf_count--;
+        pm_mem_free(buf->manager, buf, sizeof(pm_shared_buf_t) + buf->size);
+    }
+}
+
+/**
+ * @brief 释放数据块内存池中的所有空闲存储区
+ *
+ * @param self 页面管理器对象
+ */
+void stash_pool_clear(page_manager_t *self)
+{
+    for (int i = 0; i < PAGE_MANAGER_STASH_POOL_CLASSES; i++)
+    {
+        while (self->stash_pool[i] != NULL)
+        {
+            void *buffer = self->stash_pool[i];
+            self->stash_pool[i] = *(void **)buffer;
+            pm_mem_free(self, buffer, STASH_POOL_CLASS_SIZE(i));
+        }
+    }
+}
+
+/**
+ * @brief 统计数据块内存池中的空闲存储区数量
+ *
+ * @param self 页面管理器对象
+ * @return uint32_t 空闲存储区数量
+ */
+uint32_t stash_pool_free_count(page_manager_t *self)
+{
+    uint32_t count = 0;
+    for (int i = 0; i < PAGE_MANAGER_STASH_POOL_CLASSES; i++)
+    {
+        for (void *buffer = self->stash_pool[i]; buffer != NULL; buffer = *(void **)buffer)
+        {
+            count++;
+        }
+    }
+    return count;
+}
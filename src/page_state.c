@@ -1,11 +1,21 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_STATE
+
 #include "page_manager_private.h"
 
 static page_state_t _state_load_execute(page_manager_t *self, page_base_t *base);
 static page_state_t _state_will_appear_execute(page_manager_t *self, page_base_t *base);
-static page_state_t _state_did_appear_execute(page_base_t *base);
+static page_state_t _state_did_appear_execute(page_manager_t *self, page_base_t *base);
 static page_state_t _state_will_disappear_execute(page_manager_t *self, page_base_t *base);
 static page_state_t _state_did_disappear_execute(page_manager_t *self, page_base_t *base);
-static bool _get_is_over_anim(uint8_t anim);
+static void _state_view_create(page_base_t *base);
+static void _state_drag_check(page_manager_t *self, page_base_t *base);
+static void _state_view_did_load(page_base_t *base);
+static void _state_cache_update(page_base_t *base);
+static void _state_load_finish(page_manager_t *self, page_base_t *base);
+static page_state_t _state_loading_execute(page_manager_t *self, page_base_t *base);
+static void _state_load_task_cb(lv_task_t *task);
+static void _state_view_destroy(page_base_t *base);
+static bool _get_is_over_anim(const page_load_anim_attr_t *anim_attr);
 
 /**
  * @brief 页面更新
@@ -18,7 +28,9 @@ void page_state_update(page_manager_t *self, page_base_t *base)
     if (base == NULL)
         return;
 
-    switch (base->priv.state)
+    trace_state(base, (page_state_t)PAGE_HOT_STATE(base));
+
+    switch (PAGE_HOT_STATE(base))
     {
     // 页面被卸载后进入空闲状态
     case PAGE_STATE_IDLE:
@@ -28,7 +40,7 @@ void page_state_update(page_manager_t *self, page_base_t *base)
     // 该状态下执行on_view_load函数,创建root对象
     // 立即切换到PAGE_STATE_WILL_APPEAR
     case PAGE_STATE_LOAD:
-        base->priv.state = _state_load_execute(self, base);
+        PAGE_HOT_STATE(base) = _state_load_execute(self, base);
         page_state_update(self, base);
         break;
 
@@ -36,14 +48,14 @@ void page_state_update(page_manager_t *self, page_base_t *base)
     // 该状态下在动画执行之前会执行on_view_will_appear函数并且初始化切换动画
     // 动画结束后切换到PAGE_STATE_DID_APPEAR
     case PAGE_STATE_WILL_APPEAR:
-        base->priv.state = _state_will_appear_execute(self, base);
+        PAGE_HOT_STATE(base) = _state_will_appear_execute(self, base);
         break;
 
     // 由页面切换动画结束后进入这里
     // 该状态下会执行on_view_did_appear
     // 该状态执行完毕后会长期停留在PAGE_STATE_ACTIVITY状态
     case PAGE_STATE_DID_APPEAR:
-        base->priv.state = _state_did_appear_execute(base);
+        PAGE_HOT_STATE(base) = _state_did_appear_execute(self, base);
         PM_LOG_INFO("Page(%s) state active", base->name);
         break;
 
@@ -51,7 +63,7 @@ void page_state_update(page_manager_t *self, page_base_t *base)
     // 该状态会立即转到PAGE_STATE_WILL_DISAPPEAR
     case PAGE_STATE_ACTIVITY:
         PM_LOG_INFO("Page(%s) state active break", base->name);
-        base->priv.state = PAGE_STATE_WILL_DISAPPEAR;
+        PAGE_HOT_STATE(base) = PAGE_STATE_WILL_DISAPPEAR;
         page_state_update(self, base);
         break;
     
@@ -59,29 +71,35 @@ void page_state_update(page_manager_t *self, page_base_t *base)
     // 该状态会在动画开始前执行on_view_will_disappear,并且加载关机动画
     // 动画结束后进入PAGE_STATE_DID_DISAPPEAR
     case PAGE_STATE_WILL_DISAPPEAR:
-        base->priv.state = _state_will_disappear_execute(self, base);
+        PAGE_HOT_STATE(base) = _state_will_disappear_execute(self, base);
         break;
 
     // 结束动画播放完毕后进入这里
     // 该状态会执行on_view_did_disappear
     // 如果开启缓存,状态会转换成PAGE_STATE_WILL_APPEAR,如果没开启缓存则会进入PAGE_STATE_UNLOAD
     case PAGE_STATE_DID_DISAPPEAR:
-        base->priv.state = _state_did_disappear_execute(self, base);
-        if (base->priv.state == PAGE_STATE_UNLOAD)
+        PAGE_HOT_STATE(base) = _state_did_disappear_execute(self, base);
+        if (PAGE_HOT_STATE(base) == PAGE_STATE_UNLOAD)
         {
             page_state_update(self, base);
         }
         break;
 
+    // 页面提供on_view_load_step时,加载状态之后进入这里
+    // 由分帧构建任务在每帧的时间预算内推进,构建完成后切换到PAGE_STATE_WILL_APPEAR
+    case PAGE_STATE_LOADING:
+        PM_LOG_INFO("Page(%s) state loading", base->name);
+        break;
+
     // 注销页面或者是关闭页面缓存的时候会进入该状态
     // 该状态下会回收相关的页面对象,并且执行on_view_did_unload
     // 该状态结束后进入PAGE_STATE_IDLE
     case PAGE_STATE_UNLOAD:
-        base->priv.state = state_unload_execute(base);
+        PAGE_HOT_STATE(base) = state_unload_execute(base);
         break;
 
     default:
-        PM_LOG_ERROR("Page(%s) state[%d] was NOT FOUND!", base->name, base->priv.state);
+        PM_LOG_ERROR("Page(%s) state[%d] was NOT FOUND!", base->name, PAGE_HOT_STATE(base));
         break;
     }
 }
@@ -97,68 +115,285 @@ static page_state_t _state_load_execute(page_manager_t *self, page_base_t *base)
 {
     PM_LOG_INFO("Page(%s) state load", base->name);
 
+    // 等待预加载的页面被直接push,分帧预加载到一半的页面已有隐藏的根对象,继续构建
+    bool is_building = (base->priv.preload == PAGE_PRELOAD_BUILDING);
+    base->priv.preload = PAGE_PRELOAD_NONE;
+    if (!is_building)
+    {
+        _state_view_create(base);
+    }
+
+    // 分帧构建: 根对象先隐藏,让上一个页面的退出动画先开始
+    if (base->base->on_view_load_step != NULL)
+    {
+        if (self->load_task == NULL)
+        {
+            self->load_task = lv_task_create(_state_load_task_cb, PAGE_MANAGER_LOAD_PERIOD, LV_TASK_PRIO_HIGH, self);
+        }
+
+        if (self->load_task != NULL)
+        {
+            lv_obj_set_hidden(base->root, true);
+            PAGE_HOT_IS_BUSY(base) = true;
+            base->priv.load_tick = PM_TICK_US();
+            return PAGE_STATE_LOADING;
+        }
+
+        PM_LOG_ERROR("load task create failed, Page(%s) build at once", base->name);
+        while (!base->base->on_view_load_step(base))
+        {
+        }
+        lv_obj_set_hidden(base->root, false);
+    }
+
+    _state_load_finish(self, base);
+    return PAGE_STATE_WILL_APPEAR;
+}
+
+/**
+ * @brief 页面构建完成后开启拖拽,调用on_view_did_load()并更新缓存标志位
+ *
+ * @param self 页面管理器对象
+ * @param base 页面对象
+ */
+static void _state_load_finish(page_manager_t *self, page_base_t *base)
+{
+    _state_drag_check(self, base);
+    _state_view_did_load(base);
+    _state_cache_update(base);
+
+    // 被淘汰的页面重新加载,恢复淘汰前保存的状态
+    if (base->priv.is_evicted)
+    {
+        base->priv.is_evicted = false;
+        if (base->base->on_restore_state != NULL)
+        {
+            PM_LOG_INFO("Page(%s) restore state", base->name);
+            base->base->on_restore_state(base);
+        }
+    }
+}
+
+/**
+ * @brief 在时间预算内推进分帧构建
+ *
+ * @param self 页面管理器对象
+ * @param base 页面对象
+ * @return page_state_t 下一个页面状态
+ */
+static page_state_t _state_loading_execute(page_manager_t *self, page_base_t *base)
+{
+    uint32_t start = PM_TICK_US();
+    bool is_deadline = (start - base->priv.load_tick) >= PAGE_MANAGER_LOAD_DEADLINE_US;
+    bool is_done;
+
+    do
+    {
+        is_done = base->base->on_view_load_step(base);
+    } while (!is_done && (is_deadline || PM_TICK_US() - start < PAGE_MANAGER_LOAD_BUDGET_US));
+
+    if (!is_done)
+    {
+        return PAGE_STATE_LOADING;
+    }
+
+    PM_LOG_INFO("Page(%s) build finished%s", base->name, is_deadline ? " (deadline)" : "");
+    PAGE_HOT_IS_BUSY(base) = false;
+    lv_obj_set_hidden(base->root, false);
+    _state_load_finish(self, base);
+    return PAGE_STATE_WILL_APPEAR;
+}
+
+/**
+ * @brief 分帧构建任务,推进当前页面的构建,完成后开始进入动画
+ *
+ * @param task lvgl任务
+ */
+static void _state_load_task_cb(lv_task_t *task)
+{
+    page_manager_t *self = (page_manager_t *)task->user_data;
+    page_base_t *base = self->page_current;
+
+    if (base == NULL || PAGE_HOT_STATE(base) != PAGE_STATE_LOADING)
+    {
+        state_load_task_delete(self);
+        return;
+    }
+
+    PAGE_HOT_STATE(base) = _state_loading_execute(self, base);
+    if (PAGE_HOT_STATE(base) != PAGE_STATE_LOADING)
+    {
+        state_load_task_delete(self);
+        page_state_update(self, base);
+    }
+}
+
+/**
+ * @brief 删除分帧构建任务
+ *
+ * @param self 页面管理器对象
+ */
+void state_load_task_delete(page_manager_t *self)
+{
+    if (self->load_task != NULL)
+    {
+        lv_task_del(self->load_task);
+        self->load_task = NULL;
+    }
+}
+
+/**
+ * @brief 提前执行页面加载,根对象保持隐藏,直到页面被push
+ *  @note 提供on_view_load_step的页面在预加载预算内分帧构建,预算用完时停在PAGE_PRELOAD_BUILDING,
+ *        下一帧继续; 构建完成后页面标记为已缓存,push时直接进入PAGE_STATE_WILL_APPEAR
+ *
+ * @param base 页面对象
+ * @param start 本帧预加载开始的时间(us)
+ * @return page_state_t 下一个页面状态
+ */
+page_state_t state_preload_execute(page_base_t *base, uint32_t start)
+{
+    if (base->priv.preload == PAGE_PRELOAD_PENDING)
+    {
+        PM_LOG_INFO("Page(%s) state preload", base->name);
+        _state_view_create(base);
+        lv_obj_set_hidden(base->root, true);
+        base->priv.preload = PAGE_PRELOAD_BUILDING;
+    }
+
+    if (base->base->on_view_load_step != NULL)
+    {
+        bool is_done;
+        do
+        {
+            is_done = base->base->on_view_load_step(base);
+        } while (!is_done && PM_TICK_US() - start < base->manager->preload_budget_us);
+
+        if (!is_done)
+        {
+            return (page_state_t)PAGE_HOT_STATE(base);
+        }
+        PM_LOG_INFO("Page(%s) preload build finished", base->name);
+    }
+    _state_view_did_load(base);
+
+    base->priv.preload = PAGE_PRELOAD_DONE;
+    PAGE_HOT_IS_CACHED(base) = true;
+    return PAGE_STATE_WILL_APPEAR;
+}
+
+/**
+ * @brief 创建根对象,并且调用on_view_load()
+ *
+ * @param base 页面对象
+ */
+static void _state_view_create(page_base_t *base)
+{
     if (base->root != NULL)
     {
         PM_LOG_ERROR("Page(%s) root must be NULL", base->name);
     }
 
     // 创建根对象
-    lv_obj_t *root_obj = lv_obj_create(lv_scr_act(), NULL);
-    lv_obj_set_size(root_obj, LV_HOR_RES, LV_VER_RES);
+    lv_coord_t hor;
+    lv_coord_t ver;
+    get_resolution(base->manager, &hor, &ver);
+    lv_obj_t *root_obj = lv_obj_create(get_root_parent(base->manager), NULL);
+    lv_obj_set_size(root_obj, hor, ver);
     root_obj->user_data = base;
     base->root = root_obj;
+    uint32_t tick = stats_tick();
     base->base->on_view_load(base);
+    stats_since(base, PM_STAT_LOAD, &tick);
 
     if (base->root_event_cb != NULL)
     {
         lv_obj_set_event_cb(root_obj, base->root_event_cb);
     }
-    
-    if (_get_is_over_anim(page_get_current_load_anim_type(self)))
+}
+
+/**
+ * @brief 覆盖类动画且下层页面已缓存时,开启根对象的拖拽功能
+ *
+ * @param self 页面管理器对象
+ * @param base 页面对象
+ */
+static void _state_drag_check(page_manager_t *self, page_base_t *base)
+{
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(self);
+    if (anim_attr != NULL && _get_is_over_anim(anim_attr))
     {
-        page_base_t *bottom_page = get_stack_top_after(self);
+        // 页面在栈中的下一个页面,页面是栈顶时即为拖拽返回时露出的页面
+        page_base_t *bottom_page = base->priv.stack_next;
 
-        if (bottom_page != NULL && bottom_page->priv.is_cached)
+        if (bottom_page != NULL && PAGE_HOT_IS_CACHED(bottom_page))
         {
-            page_load_anim_attr_t anim_attr;
-            if (page_get_current_load_anim_attr(self, &anim_attr))
+            if (anim_attr->drag_dir != ROOT_DRAG_DIR_NONE)
             {
-                if (anim_attr.drag_dir != ROOT_DRAG_DIR_NONE)
-                {
-                    root_enable_drag(base->root);
-                }
+                root_enable_drag(base->root);
             }
         }
     }
+}
 
+/**
+ * @brief 调用on_view_did_load()
+ *
+ * @param base 页面对象
+ */
+static void _state_view_did_load(page_base_t *base)
+{
+    uint32_t tick = stats_tick();
     base->base->on_view_did_load(base);
+    stats_since(base, PM_STAT_DID_LOAD, &tick);
+}
 
+/**
+ * @brief 根据页面的缓存配置更新缓存标志位
+ *
+ * @param base 页面对象
+ */
+static void _state_cache_update(page_base_t *base)
+{
     if (base->priv.is_disable_auto_cache)
     {
         PM_LOG_INFO("Page(%s) disable auto cache, ReqEnableCache = %d", base->name, base->priv.req_enable_cache);
-        base->priv.is_cached = base->priv.req_enable_cache;
+        PAGE_HOT_IS_CACHED(base) = base->priv.req_enable_cache;
     }
     else
     {
         PM_LOG_INFO("Page(%s) AUTO cached", base->name);
-        base->priv.is_cached = true;
+        PAGE_HOT_IS_CACHED(base) = true;
     }
-
-    return PAGE_STATE_WILL_APPEAR;
 }
 
 static page_state_t _state_will_appear_execute(page_manager_t *self, page_base_t *base)
 {
     PM_LOG_INFO("Page(%s) state will appear", base->name);
+    stats_appear_begin(base);
+
+    // 预加载的页面第一次显示,补上加载时跳过的拖拽和缓存配置
+    if (base->priv.preload == PAGE_PRELOAD_DONE)
+    {
+        base->priv.preload = PAGE_PRELOAD_NONE;
+        lv_obj_set_hidden(base->root, false);
+        _state_drag_check(self, base);
+        _state_cache_update(base);
+    }
+
+    uint32_t tick = stats_tick();
     base->base->on_view_will_appear(base);
+    stats_since(base, PM_STAT_WILL_APPEAR, &tick);
     switch_anim_create(self, base);
+    stats_first_frame(self, base);
     return PAGE_STATE_DID_APPEAR;
 }
 
-static page_state_t _state_did_appear_execute(page_base_t *base)
+static page_state_t _state_did_appear_execute(page_manager_t *self, page_base_t *base)
 {
     PM_LOG_INFO("Page(%s) state did appear", base->name);
     base->base->on_view_did_appear(base);
+    stats_appear_end(self, base);
     return PAGE_STATE_ACTIVITY;
 }
 
@@ -178,9 +413,11 @@ static page_state_t _state_did_disappear_execute(page_manager_t *self, page_base
         PM_LOG_INFO("AnimState.TypeCurrent == LOAD_ANIM_FADE_ON, Page(%s) hidden", base->name);
     }
     base->base->on_view_did_disappear(base);
-    if (base->priv.is_cached)
+    if (PAGE_HOT_IS_CACHED(base))
     {
         PM_LOG_INFO("Page(%s) has cached", base->name);
+        base->priv.cache_tick = lv_tick_get();
+        base->priv.cache_objs = lv_obj_count_children_recursive(base->root) + 1;
         return PAGE_STATE_WILL_APPEAR;
     }
     else
@@ -192,29 +429,123 @@ static page_state_t _state_did_disappear_execute(page_manager_t *self, page_base
 page_state_t state_unload_execute(page_base_t* base)
 {
     PM_LOG_INFO("Page(%s) state unload", base->name);
+
+    // 被淘汰的页面没有根对象,但仍持有数据块
+    if (base->priv.stash.ptr != NULL)
+    {
+        PM_LOG_INFO("Page(%s) free stash(0x%p)[%d]", base->name, base->priv.stash.ptr, base->priv.stash.size);
+        stash_release(base);
+    }
+    base->priv.is_evicted = false;
+
     if (base->root == NULL)
     {
         PM_LOG_WARN("Page is loaded!");
         goto Exit;
     }
 
-    if (base->priv.stash.ptr != NULL && base->priv.stash.size != 0)
+    _state_view_destroy(base);
+
+Exit:
+    return PAGE_STATE_IDLE;
+}
+
+/**
+ * @brief 淘汰缓存页面
+ *  @note 页面栈中的页面保留数据块,调用on_save_state后删除根对象,pop时重新加载;
+ *        不在页面栈中的页面直接卸载
+ *
+ * @param base 页面对象
+ * @return page_state_t 下一个页面状态
+ */
+page_state_t state_evict_execute(page_base_t *base)
+{
+    if (!PAGE_HOT_IS_IN_STACK(base))
     {
-        PM_LOG_INFO("Page(%s) free stash(0x%p)[%d]", base->name, base->priv.stash.ptr, base->priv.stash.size);
-        PM_FREE(base->priv.stash.ptr);
-        base->priv.stash.ptr = NULL;
-        base->priv.stash.size = 0;
+        return state_unload_execute(base);
+    }
+
+    PM_LOG_INFO("Page(%s) state evict", base->name);
+    if (base->base->on_save_state != NULL)
+    {
+        base->base->on_save_state(base);
+    }
+    base->priv.is_evicted = true;
+    _state_view_destroy(base);
+    return PAGE_STATE_IDLE;
+}
+
+/**
+ * @brief 栈顶下方的页面已被淘汰时重新加载,作为缓存页面等待拖拽返回时露出
+ *  @note 只有可拖拽的覆盖类动画会露出下层页面;重新加载时调用on_restore_state,
+ *        根对象移到栈中更深的页面之后,由遮挡检查决定是否隐藏
+ *
+ * @param self 页面管理器对象
+ */
+void state_under_restore(page_manager_t *self)
+{
+    page_base_t *base = self->stack_top != NULL ? self->stack_top->priv.stack_next : NULL;
+    if (base == NULL || base->root != NULL || !base->priv.is_evicted)
+    {
+        return;
+    }
+
+    const page_load_anim_attr_t *anim_attr = page_get_current_load_anim_attr(self);
+    if (anim_attr == NULL || !_get_is_over_anim(anim_attr) || anim_attr->drag_dir == ROOT_DRAG_DIR_NONE)
+    {
+        return;
+    }
+
+    PM_LOG_INFO("Page(%s) state restore under stack top", base->name);
+    _state_view_create(base);
+    if (base->base->on_view_load_step != NULL)
+    {
+        while (!base->base->on_view_load_step(base))
+        {
+        }
     }
+    _state_load_finish(self, base);
+
+    // 新建的根对象在最上层,按栈的顺序放回当前页面之下
+    for (page_base_t *node = base; node != NULL; node = node->priv.stack_next)
+    {
+        if (node->root != NULL)
+        {
+            lv_obj_move_background(node->root);
+        }
+    }
+
+    PAGE_HOT_IS_CACHED(base) = true;
+    PAGE_HOT_STATE(base) = PAGE_STATE_WILL_APPEAR;
+    base->priv.cache_tick = lv_tick_get();
+    base->priv.cache_objs = lv_obj_count_children_recursive(base->root) + 1;
+}
+
+/**
+ * @brief 删除根对象,并且调用on_view_did_unload()
+ *
+ * @param base 页面对象
+ */
+static void _state_view_destroy(page_base_t *base)
+{
     lv_obj_del_async(base->root);
     base->root = NULL;
-    base->priv.is_cached = false;
+    base->priv.anim.is_interrupted = false;
+    base->priv.preload = PAGE_PRELOAD_NONE;
+    base->priv.is_occluded = false;
+    PAGE_HOT_IS_CACHED(base) = false;
     base->base->on_view_did_unload(base);
-
-Exit:
-    return PAGE_STATE_IDLE;
 }
 
-static bool _get_is_over_anim(uint8_t anim)
+/**
+ * @brief 检测是否为覆盖类动画
+ *  @note push时退出的页面不动,新页面覆盖在上面,拖拽时可以露出下层页面
+ *
+ * @param anim_attr 动画属性
+ * @return true 覆盖类动画
+ * @return false 其他动画
+ */
+static bool _get_is_over_anim(const page_load_anim_attr_t *anim_attr)
 {
-    return (anim >= LOAD_ANIM_OVER_LEFT && anim <= LOAD_ANIM_OVER_BOTTOM);
+    return anim_attr->push.exit.start == anim_attr->push.exit.end;
 }
\ No newline at end of file
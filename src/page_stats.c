@@ -0,0 +1,224 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_STATS
+
+#include "page_manager_private.h"
+
+static pm_clock_cb_t _clock_cb;
+
+/**
+ * @brief 设置微秒时钟
+ *
+ * @param clock_cb 时钟回调,NULL时恢复为lv_tick_get()换算
+ */
+void pm_set_clock(pm_clock_cb_t clock_cb)
+{
+    _clock_cb = clock_cb;
+}
+
+/**
+ * @brief 获取当前时钟
+ *
+ * @return uint32_t 微秒
+ */
+uint32_t pm_clock_us(void)
+{
+    if (_clock_cb != NULL)
+    {
+        return _clock_cb();
+    }
+    return (uint32_t)lv_tick_get() * 1000;
+}
+
+#if PAGE_MANAGER_USE_STATS
+
+static const char *const _stat_names[_PM_STAT_LAST] = {
+    "load",
+    "did_load",
+    "will_appear",
+    "transition",
+    "first_frame",
+    "appear_cached",
+    "appear_uncached",
+};
+
+/**
+ * @brief 记录一次耗时
+ *
+ * @param base 页面对象
+ * @param metric 统计项
+ * @param us 耗时(us)
+ */
+void stats_record(page_base_t *base, pm_stat_metric_t metric, uint32_t us)
+{
+    pm_stat_hist_t *hist = &base->stats.data.hist[metric];
+
+    uint8_t bucket = 0;
+    while (bucket < PM_STAT_BUCKETS - 1 && us >= (500u << bucket))
+    {
+        bucket++;
+    }
+
+    if (hist->buckets[bucket] != UINT16_MAX)
+    {
+        hist->buckets[bucket]++;
+    }
+    hist->count++;
+    hist->sum_us += us;
+    if (us > hist->max_us)
+    {
+        hist->max_us = us;
+    }
+}
+
+/**
+ * @brief 获取页面的生命周期耗时统计
+ *
+ * @param self 页面管理器对象
+ * @param name 页面名称
+ * @param stats [out]耗时统计
+ * @return true 获取成功
+ * @return false 页面未安装
+ */
+bool pm_get_page_stats(page_manager_t *self, const char *name, pm_page_stats_t *stats)
+{
+    page_base_t *base = find_page_pool(self, name);
+    if (base == NULL)
+    {
+        PM_LOG_ERROR("Page(%s) was not install", name);
+        return false;
+    }
+    *stats = base->stats.data;
+    return true;
+}
+
+/**
+ * @brief 清空所有页面的耗时统计
+ *
+ * @param self 页面管理器对象
+ */
+void pm_reset_stats(page_manager_t *self)
+{
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        memset(&self->page_table[i].stats.data, 0, sizeof(pm_page_stats_t));
+    }
+}
+
+/**
+ * @brief 打印所有页面的耗时统计
+ *
+ * @param self 页面管理器对象
+ */
+void pm_dump_stats(page_manager_t *self)
+{
+    printf("[PM] page stats, bucket upper bound = 500us << i\r\n");
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        page_base_t *base = &self->page_table[i];
+        if (base->manager == NULL)
+        {
+            continue;
+        }
+
+        for (int m = 0; m < _PM_STAT_LAST; m++)
+        {
+            pm_stat_hist_t *hist = &base->stats.data.hist[m];
+            if (hist->count == 0)
+            {
+                continue;
+            }
+
+            printf("[PM] %s.%s count=%u avg=%uus max=%uus buckets=",
+                   base->name,
+                   _stat_names[m],
+                   (unsigned int)hist->count,
+                   (unsigned int)(hist->sum_us / hist->count),
+                   (unsigned int)hist->max_us);
+            for (int b = 0; b < PM_STAT_BUCKETS; b++)
+            {
+                printf("%s%u", b ? "," : "", (unsigned int)hist->buckets[b]);
+            }
+            printf("\r\n");
+        }
+    }
+}
+
+/**
+ * @brief 以JSON格式输出所有页面的耗时统计
+ *  @note 格式: {"bucket_base_us":500,"pages":{"页面名":{"统计项":{"count":..,"avg_us":..,"max_us":..,"buckets":[..]}}}}
+ *
+ * @param self 页面管理器对象
+ * @param fp 输出文件
+ */
+void pm_dump_stats_json(page_manager_t *self, FILE *fp)
+{
+    bool need_comma = false;
+
+    fprintf(fp, "{\"bucket_base_us\":500,\"pages\":{");
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        page_base_t *base = &self->page_table[i];
+        if (base->manager == NULL)
+        {
+            continue;
+        }
+
+        fprintf(fp, "%s\n\"%s\":{", need_comma ? "," : "", base->name);
+        need_comma = true;
+
+        bool need_metric_comma = false;
+        for (int m = 0; m < _PM_STAT_LAST; m++)
+        {
+            pm_stat_hist_t *hist = &base->stats.data.hist[m];
+            if (hist->count == 0)
+            {
+                continue;
+            }
+
+            fprintf(fp, "%s\"%s\":{\"count\":%u,\"avg_us\":%u,\"max_us\":%u,\"buckets\":[",
+                    need_metric_comma ? "," : "",
+                    _stat_names[m],
+                    (unsigned int)hist->count,
+                    (unsigned int)(hist->sum_us / hist->count),
+                    (unsigned int)hist->max_us);
+            for (int b = 0; b < PM_STAT_BUCKETS; b++)
+            {
+                fprintf(fp, "%s%u", b ? "," : "", (unsigned int)hist->buckets[b]);
+            }
+            fprintf(fp, "]}");
+            need_metric_comma = true;
+        }
+        fprintf(fp, "}");
+    }
+    fprintf(fp, "\n}}\n");
+}
+
+#else
+
+bool pm_get_page_stats(page_manager_t *self, const char *name, pm_page_stats_t *stats)
+{
+    (void)self;
+    (void)name;
+    (void)stats;
+    PM_LOG_WARN("PAGE_MANAGER_USE_STATS is disabled");
+    return false;
+}
+
+void pm_reset_stats(page_manager_t *self)
+{
+    (void)self;
+}
+
+void pm_dump_stats(page_manager_t *self)
+{
+    (void)self;
+    PM_LOG_WARN("PAGE_MANAGER_USE_STATS is disabled");
+}
+
+void pm_dump_stats_json(page_manager_t *self, FILE *fp)
+{
+    (void)self;
+    fprintf(fp, "{}\n");
+    PM_LOG_WARN("PAGE_MANAGER_USE_STATS is disabled");
+}
+
+#endif
@@ -0,0 +1,226 @@
+#define PM_LOG_MODULE_LEVEL PAGE_MANAGER_LOG_LEVEL_TRACE
+
+#include "page_manager_private.h"
+
+#if PAGE_MANAGER_USE_TRACE
+
+/* Linux下同时提供USDT静态探针,可用bpftrace/perf等工具挂载 */
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PM_TRACE_USE_USDT 1
+#endif
+#endif
+
+#ifndef PM_TRACE_USE_USDT
+#define PM_TRACE_USE_USDT 0
+#endif
+
+static FILE *_trace_file;
+static bool _trace_need_comma;
+static bool _trace_in_drag;
+
+static const char *const _state_names[_PAGE_STATE_LAST] = {
+    "IDLE",
+    "LOAD",
+    "WILL_APPEAR",
+    "DID_APPEAR",
+    "ACTIVITY",
+    "WILL_DISAPPEAR",
+    "DID_DISAPPEAR",
+    "UNLOAD",
+    "LOADING",
+};
+
+/**
+ * @brief 以JSON字符串转义写入文本
+ *  @note 页面名称由用户指定,可能含有引号、反斜杠或控制字符
+ *
+ * @param str 文本,NULL时写入空串
+ */
+static void _trace_write_str(const char *str)
+{
+    fputc('"', _trace_file);
+    for (const char *p = str; p != NULL && *p != '\0'; p++)
+    {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', _trace_file);
+            fputc(c, _trace_file);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(_trace_file, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, _trace_file);
+        }
+    }
+    fputc('"', _trace_file);
+}
+
+/**
+ * @brief 写入一条trace事件
+ *
+ * @param ph 事件类型,见Chrome Trace Event Format
+ * @param cat 事件分类
+ * @param name 事件名
+ * @param id 异步事件ID,非异步事件忽略
+ * @param base 页面对象
+ */
+static void _trace_event(char ph, const char *cat, const char *name, uint32_t id, page_base_t *base)
+{
+    if (_trace_file == NULL)
+    {
+        return;
+    }
+
+    fprintf(_trace_file,
+            "%s{\"ph\":\"%c\",\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%u,\"pid\":1,\"tid\":1,\"id\":%u,"
+            "\"args\":{\"page\":",
+            _trace_need_comma ? ",\n" : "",
+            ph,
+            cat,
+            name,
+            (unsigned int)PM_TICK_US(),
+            (unsigned int)id);
+    _trace_write_str(base->name);
+    fprintf(_trace_file,
+            ",\"manager\":\"%p\"}%s}",
+            (void *)base->manager,
+            (ph == 'i') ? ",\"s\":\"t\"" : "");
+    _trace_need_comma = true;
+}
+
+/**
+ * @brief 开始记录trace,事件以Chrome/Perfetto JSON格式写入文件
+ *
+ * @param path 文件路径
+ * @return true 开始成功
+ * @return false 文件打开失败
+ */
+bool pm_trace_start(const char *path)
+{
+    pm_trace_stop();
+
+    _trace_file = fopen(path, "w");
+    if (_trace_file == NULL)
+    {
+        PM_LOG_ERROR("trace file(%s) open failed", path);
+        return false;
+    }
+
+    fprintf(_trace_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    _trace_need_comma = false;
+    _trace_in_drag = false;
+    PM_LOG_INFO("trace start >> %s", path);
+    return true;
+}
+
+/**
+ * @brief 停止记录trace并关闭文件
+ */
+void pm_trace_stop(void)
+{
+    if (_trace_file == NULL)
+    {
+        return;
+    }
+
+    fprintf(_trace_file, "\n]}\n");
+    fclose(_trace_file);
+    _trace_file = NULL;
+    PM_LOG_INFO("trace stop");
+}
+
+/**
+ * @brief 记录页面状态切换
+ *
+ * @param base 页面对象
+ * @param state 进入的状态
+ */
+void trace_state(page_base_t *base, page_state_t state)
+{
+    const char *name = (state < _PAGE_STATE_LAST) ? _state_names[state] : "UNKNOWN";
+#if PM_TRACE_USE_USDT
+    DTRACE_PROBE2(page_manager, state, base->name, (int)state);
+#endif
+    _trace_event('i', "state", name, 0, base);
+}
+
+/**
+ * @brief 记录切换动画开始
+ *
+ * @param base 页面对象
+ */
+void trace_anim_begin(page_base_t *base)
+{
+#if PM_TRACE_USE_USDT
+    DTRACE_PROBE2(page_manager, anim_begin, base->name, (int)base->priv.anim.is_enter);
+#endif
+    _trace_event('b', "anim", base->priv.anim.is_enter ? "anim_enter" : "anim_exit", base->id, base);
+}
+
+/**
+ * @brief 记录切换动画结束
+ *
+ * @param base 页面对象
+ */
+void trace_anim_end(page_base_t *base)
+{
+#if PM_TRACE_USE_USDT
+    DTRACE_PROBE2(page_manager, anim_end, base->name, (int)base->priv.anim.is_enter);
+#endif
+    _trace_event('e', "anim", base->priv.anim.is_enter ? "anim_enter" : "anim_exit", base->id, base);
+}
+
+/**
+ * @brief 记录页面拖拽阶段
+ *
+ * @param base 页面对象
+ * @param event 拖拽事件
+ */
+void trace_drag(page_base_t *base, lv_event_t event)
+{
+#if PM_TRACE_USE_USDT
+    DTRACE_PROBE2(page_manager, drag, base->name, (int)event);
+#endif
+    switch (event)
+    {
+    case LV_EVENT_PRESSED:
+        _trace_event('B', "drag", "drag", 0, base);
+        _trace_in_drag = true;
+        break;
+    case LV_EVENT_PRESSING:
+        _trace_event('i', "drag", "drag_move", 0, base);
+        break;
+    case LV_EVENT_RELEASED:
+    case LV_EVENT_PRESS_LOST:
+        // 按下丢失后不一定还会收到释放事件,两者都结束拖拽,只记录一次
+        if (_trace_in_drag)
+        {
+            _trace_event('E', "drag", "drag", 0, base);
+            _trace_in_drag = false;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+#else
+
+bool pm_trace_start(const char *path)
+{
+    (void)path;
+    PM_LOG_WARN("PAGE_MANAGER_USE_TRACE is disabled");
+    return false;
+}
+
+void pm_trace_stop(void)
+{
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * 淡入淡出基准测试,基于lvgl桩: 内置的LOAD_ANIM_FADE_ON(opa_scale,数值不变时不写样式,结束后删除本地样式)
+ * 与原来每帧写bg_opa本地样式的setter对比,记录每帧耗时和每帧样式写入次数
+ * 命令行参数见bench_util.h
+ */
+#include <stdio.h>
+
+#include "bench_util.h"
+#include "harness.h"
+
+#define BENCH_PAGE_OBJS 8 // 每个页面的子对象数量
+#define BENCH_ANIM_TIME 300
+
+static uint32_t iterations;
+
+static void bench_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void bench_page_load(page_base_t *self)
+{
+    for (uint8_t i = 0; i < BENCH_PAGE_OBJS; i++)
+    {
+        lv_obj_create(self->root, NULL);
+    }
+}
+
+static void bench_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t bench_page = {
+    .on_custom_attr_config = bench_page_cfg,
+    .on_view_load = bench_page_load,
+    .on_view_did_load = bench_page_noop,
+    .on_view_will_appear = bench_page_noop,
+    .on_view_did_appear = bench_page_noop,
+    .on_view_will_disappear = bench_page_noop,
+    .on_view_did_disappear = bench_page_noop,
+    .on_view_did_unload = bench_page_noop,
+};
+
+/* 原来的淡入淡出: 每帧写根对象的bg_opa本地样式,子对象不受影响,样式一直保留 */
+static void bench_legacy_setter(void *obj, int16_t v)
+{
+    lv_obj_set_style_local_bg_opa((lv_obj_t *)obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (lv_opa_t)v);
+}
+
+static int32_t bench_legacy_getter(void *obj)
+{
+    return (int32_t)lv_obj_get_style_bg_opa((lv_obj_t *)obj, LV_OBJ_PART_MAIN);
+}
+
+static const pm_anim_type_t bench_legacy_fade = {
+    .setter = bench_legacy_setter,
+    .getter = bench_legacy_getter,
+    .drag_dir = ROOT_DRAG_DIR_NONE,
+    .unit = PM_ANIM_UNIT_VALUE,
+    .push = {{LV_OPA_TRANSP, LV_OPA_COVER}, {LV_OPA_COVER, LV_OPA_COVER}},
+    .pop = {{LV_OPA_COVER, LV_OPA_COVER}, {LV_OPA_COVER, LV_OPA_TRANSP}},
+};
+
+/**
+ * @brief 用指定的动画类型反复push/pop,记录每帧耗时和样式写入次数
+ *
+ * @param name 指标名称前缀
+ * @param legacy true 注册并使用原来的setter; false 使用内置的LOAD_ANIM_FADE_ON
+ */
+static void bench_fade(const char *name, bool legacy)
+{
+    char metric[48];
+    uint32_t cycles = iterations / 10 + 1;
+    uint32_t frames = cycles * 2 * (BENCH_ANIM_TIME / HARNESS_FRAME_MS + 1);
+
+    page_manager_t *manager = page_manager_create();
+    pm_install(manager, "a", &bench_page);
+    pm_install(manager, "b", &bench_page);
+    uint8_t anim = legacy ? pm_register_anim_type(manager, &bench_legacy_fade) : LOAD_ANIM_FADE_ON;
+    pm_set_global_load_anim_type(manager, anim, BENCH_ANIM_TIME, lv_anim_path_linear);
+    pm_push(manager, "a", NULL);
+    harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+    pm_push(manager, "b", NULL);
+    harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+    pm_pop(manager);
+    harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+
+    uint32_t writes = lv_stub_style_write_count();
+    uint64_t start = harness_now_ns();
+    for (uint32_t i = 0; i < cycles; i++)
+    {
+        pm_push(manager, "b", NULL);
+        harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+        pm_pop(manager);
+        harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+    }
+    snprintf(metric, sizeof(metric), "%s_frame_ns", name);
+    bench_record(metric, (double)(harness_now_ns() - start) / frames);
+    snprintf(metric, sizeof(metric), "%s_style_writes_per_frame", name);
+    bench_record(metric, (double)(lv_stub_style_write_count() - writes) / frames);
+
+    page_manager_delete(manager);
+    harness_run(HARNESS_FRAME_MS);
+}
+
+int main(int argc, char **argv)
+{
+    iterations = bench_init(argc, argv, 2000);
+    harness_init();
+    bench_fade("fade_opa_scale", false);
+    bench_fade("fade_bg_opa_legacy", true);
+    return bench_finish("bench_fade");
+}
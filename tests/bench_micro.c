@@ -0,0 +1,184 @@
+/**
+ * 微基准测试,基于lvgl桩: pm_push/pm_pop调用、切换完成、状态机分发的单次耗时和内存申请次数
+ * 命令行参数见bench_util.h
+ */
+#include <stdio.h>
+
+#include "bench_util.h"
+#include "harness.h"
+#include "page_manager_private.h"
+
+static uint32_t iterations;
+
+static void bench_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void bench_page_load(page_base_t *self)
+{
+    lv_obj_create(self->root, NULL);
+}
+
+static void bench_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t bench_page = {
+    .on_custom_attr_config = bench_page_cfg,
+    .on_view_load = bench_page_load,
+    .on_view_did_load = bench_page_noop,
+    .on_view_will_appear = bench_page_noop,
+    .on_view_did_appear = bench_page_noop,
+    .on_view_will_disappear = bench_page_noop,
+    .on_view_did_disappear = bench_page_noop,
+    .on_view_did_unload = bench_page_noop,
+};
+
+/* 一项微基准的累计值 */
+typedef struct
+{
+    uint64_t ns;
+    uint32_t pm_allocs;
+    uint32_t lv_allocs;
+    uint64_t start_ns;
+    uint32_t start_pm_allocs;
+    uint32_t start_lv_allocs;
+} bench_acc_t;
+
+static page_manager_t *manager;
+
+static void bench_acc_begin(bench_acc_t *acc)
+{
+    pm_alloc_stat_t stat;
+    pm_get_alloc_stat(manager, &stat);
+    acc->start_pm_allocs = stat.alloc_count;
+    acc->start_lv_allocs = lv_stub_alloc_count();
+    acc->start_ns = harness_now_ns();
+}
+
+static void bench_acc_end(bench_acc_t *acc)
+{
+    acc->ns += harness_now_ns() - acc->start_ns;
+    pm_alloc_stat_t stat;
+    pm_get_alloc_stat(manager, &stat);
+    acc->pm_allocs += stat.alloc_count - acc->start_pm_allocs;
+    acc->lv_allocs += lv_stub_alloc_count() - acc->start_lv_allocs;
+}
+
+/**
+ * @brief 记录一项微基准的ns/op和allocs/op
+ *
+ * @param name 名称
+ * @param acc 累计值
+ * @param ops 操作次数
+ */
+static void bench_acc_record(const char *name, const bench_acc_t *acc, uint32_t ops)
+{
+    char metric[48];
+    snprintf(metric, sizeof(metric), "%s_ns", name);
+    bench_record(metric, (double)acc->ns / ops);
+    snprintf(metric, sizeof(metric), "%s_pm_allocs", name);
+    bench_record(metric, (double)acc->pm_allocs / ops);
+    snprintf(metric, sizeof(metric), "%s_lv_allocs", name);
+    bench_record(metric, (double)acc->lv_allocs / ops);
+}
+
+/**
+ * @brief 缓存页面之间无动画的push/pop: 分别计量调用本身和切换完成的那一帧
+ */
+static void bench_push_pop(void)
+{
+    bench_acc_t push = {0};
+    bench_acc_t pop = {0};
+    bench_acc_t finish = {0};
+
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_NONE, 0, lv_anim_path_linear);
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        bench_acc_begin(&push);
+        pm_push(manager, "b", NULL);
+        bench_acc_end(&push);
+
+        bench_acc_begin(&finish);
+        harness_run(HARNESS_FRAME_MS);
+        bench_acc_end(&finish);
+
+        bench_acc_begin(&pop);
+        pm_pop(manager);
+        bench_acc_end(&pop);
+
+        bench_acc_begin(&finish);
+        harness_run(HARNESS_FRAME_MS);
+        bench_acc_end(&finish);
+    }
+    bench_acc_record("pm_push", &push, iterations);
+    bench_acc_record("pm_pop", &pop, iterations);
+    bench_acc_record("switch_finish", &finish, iterations * 2);
+}
+
+/**
+ * @brief 完整的覆盖动画切换,包括请求和每一帧动画
+ */
+static void bench_switch(void)
+{
+    bench_acc_t sw = {0};
+    uint16_t anim_time = 100;
+
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, anim_time, lv_anim_path_linear);
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        bench_acc_begin(&sw);
+        pm_push(manager, "b", NULL);
+        harness_run(anim_time + HARNESS_FRAME_MS);
+        pm_pop(manager);
+        harness_run(anim_time + HARNESS_FRAME_MS);
+        bench_acc_end(&sw);
+    }
+    bench_acc_record("switch_over", &sw, iterations * 2);
+}
+
+/**
+ * @brief 状态机分发: 在栈顶页面上重复执行PAGE_STATE_DID_APPEAR -> PAGE_STATE_ACTIVITY
+ */
+static void bench_state_update(void)
+{
+    bench_acc_t update = {0};
+    page_base_t *base = manager->page_current;
+    uint32_t ops = iterations * 100;
+
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        PAGE_HOT_STATE(base) = PAGE_STATE_DID_APPEAR;
+        bench_acc_begin(&update);
+        page_state_update(manager, base);
+        bench_acc_end(&update);
+    }
+    bench_acc_record("page_state_update", &update, ops);
+}
+
+int main(int argc, char **argv)
+{
+    iterations = bench_init(argc, argv, 10000);
+    harness_init();
+
+    manager = page_manager_create();
+    pm_install(manager, "a", &bench_page);
+    pm_install(manager, "b", &bench_page);
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_NONE, 0, lv_anim_path_linear);
+    pm_push(manager, "a", NULL);
+    harness_run(HARNESS_FRAME_MS);
+    pm_push(manager, "b", NULL);
+    harness_run(HARNESS_FRAME_MS);
+    pm_pop(manager);
+    harness_run(HARNESS_FRAME_MS);
+
+    bench_push_pop();
+    bench_switch();
+    bench_state_update();
+
+    page_manager_delete(manager);
+    harness_run(HARNESS_FRAME_MS);
+    return bench_finish("bench_micro");
+}
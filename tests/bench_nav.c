@@ -0,0 +1,282 @@
+/**
+ * 页面导航端到端基准测试: push/pop吞吐量、各动画类型每帧耗时、拖拽、页面数量和栈深度的影响
+ * 命令行参数见bench_util.h
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench_util.h"
+#include "harness.h"
+
+#define BENCH_PAGE_OBJS 8 // 每个页面的子对象数量
+#define BENCH_ANIM_TIME 200
+
+static uint32_t iterations;
+static char page_names[PAGE_MANAGER_PAGE_MAX][8];
+
+static const char *const anim_names[] = {
+    [LOAD_ANIM_OVER_LEFT] = "over_left",
+    [LOAD_ANIM_OVER_RIGHT] = "over_right",
+    [LOAD_ANIM_OVER_TOP] = "over_top",
+    [LOAD_ANIM_OVER_BOTTOM] = "over_bottom",
+    [LOAD_ANIM_MOVE_LEFT] = "move_left",
+    [LOAD_ANIM_MOVE_RIGHT] = "move_right",
+    [LOAD_ANIM_MOVE_TOP] = "move_top",
+    [LOAD_ANIM_MOVE_BOTTOM] = "move_bottom",
+    [LOAD_ANIM_FADE_ON] = "fade_on",
+    [LOAD_ANIM_NONE] = "none",
+};
+
+static void bench_page_cfg(page_base_t *self)
+{
+    (void)self;
+}
+
+static void bench_page_cfg_cached(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void bench_page_load(page_base_t *self)
+{
+    for (uint8_t i = 0; i < BENCH_PAGE_OBJS; i++)
+    {
+        lv_obj_t *obj = lv_obj_create(self->root, NULL);
+        lv_obj_set_click(obj, false);
+        lv_obj_set_size(obj, HARNESS_HOR_RES / 2, HARNESS_VER_RES / BENCH_PAGE_OBJS);
+        lv_obj_set_pos(obj, 0, i * (HARNESS_VER_RES / BENCH_PAGE_OBJS));
+    }
+}
+
+static void bench_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t bench_page = {
+    .on_custom_attr_config = bench_page_cfg,
+    .on_view_load = bench_page_load,
+    .on_view_did_load = bench_page_noop,
+    .on_view_will_appear = bench_page_noop,
+    .on_view_did_appear = bench_page_noop,
+    .on_view_will_disappear = bench_page_noop,
+    .on_view_did_disappear = bench_page_noop,
+    .on_view_did_unload = bench_page_noop,
+};
+
+static page_vtable_t bench_page_cached = {
+    .on_custom_attr_config = bench_page_cfg_cached,
+    .on_view_load = bench_page_load,
+    .on_view_did_load = bench_page_noop,
+    .on_view_will_appear = bench_page_noop,
+    .on_view_did_appear = bench_page_noop,
+    .on_view_will_disappear = bench_page_noop,
+    .on_view_did_disappear = bench_page_noop,
+    .on_view_did_unload = bench_page_noop,
+};
+
+/**
+ * @brief 创建页面管理器并安装页面p0..p(count-1),p0入栈
+ *
+ * @param count 页面数量
+ * @param page 页面虚函数表
+ * @return page_manager_t* 页面管理器对象
+ */
+static page_manager_t *bench_manager_create(uint16_t count, page_vtable_t *page)
+{
+    page_manager_t *manager = page_manager_create();
+    for (uint16_t i = 0; i < count; i++)
+    {
+        pm_install(manager, page_names[i], page);
+    }
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_NONE, 0, lv_anim_path_linear);
+    pm_push(manager, page_names[0], NULL);
+    harness_run(HARNESS_FRAME_MS);
+    return manager;
+}
+
+/**
+ * @brief push一个页面再pop,各运行一帧
+ *
+ * @param manager 页面管理器对象
+ * @param name 页面名称
+ */
+static void bench_push_pop(page_manager_t *manager, const char *name)
+{
+    pm_push(manager, name, NULL);
+    harness_run(HARNESS_FRAME_MS);
+    pm_pop(manager);
+    harness_run(HARNESS_FRAME_MS);
+}
+
+/**
+ * @brief 无动画的push/pop吞吐量,页面缓存和不缓存两种情况
+ */
+static void bench_push_pop_throughput(void)
+{
+    page_vtable_t *pages[] = {&bench_page, &bench_page_cached};
+    const char *names[] = {"push_pop_uncached_ns", "push_pop_cached_ns"};
+
+    for (uint8_t p = 0; p < 2; p++)
+    {
+        page_manager_t *manager = bench_manager_create(2, pages[p]);
+        bench_push_pop(manager, page_names[1]);
+
+        uint64_t start = harness_now_ns();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            bench_push_pop(manager, page_names[1]);
+        }
+        bench_record(names[p], (double)(harness_now_ns() - start) / iterations);
+        page_manager_delete(manager);
+        harness_run(HARNESS_FRAME_MS);
+    }
+}
+
+/**
+ * @brief 各动画类型切换期间每帧的耗时,以空闲帧为参照
+ */
+static void bench_anim_frame_cost(void)
+{
+    char name[48];
+    uint32_t cycles = iterations / 50 + 1;
+    uint32_t frames = cycles * 2 * (BENCH_ANIM_TIME / HARNESS_FRAME_MS + 1);
+    page_manager_t *manager = bench_manager_create(2, &bench_page_cached);
+
+    uint64_t start = harness_now_ns();
+    harness_run(frames * HARNESS_FRAME_MS);
+    bench_record("frame_idle_ns", (double)(harness_now_ns() - start) / frames);
+
+    for (uint8_t type = LOAD_ANIM_OVER_LEFT; type <= LOAD_ANIM_NONE; type++)
+    {
+        pm_set_global_load_anim_type(manager, type, BENCH_ANIM_TIME, lv_anim_path_linear);
+        start = harness_now_ns();
+        for (uint32_t i = 0; i < cycles; i++)
+        {
+            pm_push(manager, page_names[1], NULL);
+            harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+            pm_pop(manager);
+            harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+        }
+        snprintf(name, sizeof(name), "frame_%s_ns", anim_names[type]);
+        bench_record(name, (double)(harness_now_ns() - start) / frames);
+    }
+    page_manager_delete(manager);
+    harness_run(HARNESS_FRAME_MS);
+}
+
+/**
+ * @brief 拖拽返回每帧的耗时,拖拽距离不足以返回,松开后页面回弹
+ */
+static void bench_drag(void)
+{
+    uint16_t steps = 20;
+    uint32_t cycles = iterations / 50 + 1;
+    page_manager_t *manager = bench_manager_create(2, &bench_page_cached);
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, BENCH_ANIM_TIME, lv_anim_path_linear);
+    pm_push(manager, page_names[1], NULL);
+    harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+
+    uint64_t elapsed = 0;
+    for (uint32_t i = 0; i < cycles; i++)
+    {
+        uint64_t start = harness_now_ns();
+        harness_drag(manager->stack_top->root, HARNESS_HOR_RES / 8, 0, steps);
+        elapsed += harness_now_ns() - start;
+        harness_run(BENCH_ANIM_TIME + HARNESS_FRAME_MS);
+    }
+    bench_record("drag_step_ns", (double)elapsed / ((uint64_t)cycles * (steps + 2)));
+    page_manager_delete(manager);
+    harness_run(HARNESS_FRAME_MS);
+}
+
+/**
+ * @brief 已安装页面数量对按名称push/pop的影响
+ */
+static void bench_page_count_scaling(void)
+{
+    static const uint16_t counts[] = {10, 100, 1000};
+    char name[48];
+
+    for (uint8_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        if (counts[c] > PAGE_MANAGER_PAGE_MAX)
+        {
+            break;
+        }
+        page_manager_t *manager = bench_manager_create(counts[c], &bench_page);
+        srand(1);
+        uint64_t start = harness_now_ns();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            bench_push_pop(manager, page_names[1 + rand() % (counts[c] - 1)]);
+        }
+        snprintf(name, sizeof(name), "push_pop_pages_%u_ns", counts[c]);
+        bench_record(name, (double)(harness_now_ns() - start) / iterations);
+        page_manager_delete(manager);
+        harness_run(HARNESS_FRAME_MS);
+    }
+}
+
+/**
+ * @brief 页面栈深度对push/pop和返回栈底的影响
+ */
+static void bench_stack_depth(void)
+{
+    static const uint16_t depths[] = {10, 100};
+    char name[48];
+
+    for (uint8_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++)
+    {
+        uint16_t depth = depths[d];
+        if (depth + 1 > PAGE_MANAGER_PAGE_MAX)
+        {
+            break;
+        }
+        page_manager_t *manager = bench_manager_create(depth + 1, &bench_page_cached);
+        uint32_t cycles = iterations / depth + 1;
+        uint64_t push_pop = 0;
+        uint64_t back_home = 0;
+
+        for (uint32_t i = 0; i < cycles; i++)
+        {
+            for (uint16_t level = 1; level < depth; level++)
+            {
+                pm_push(manager, page_names[level], NULL);
+                harness_run(HARNESS_FRAME_MS);
+            }
+
+            uint64_t start = harness_now_ns();
+            bench_push_pop(manager, page_names[depth]);
+            push_pop += harness_now_ns() - start;
+
+            start = harness_now_ns();
+            pm_back_home(manager);
+            harness_run(HARNESS_FRAME_MS);
+            back_home += harness_now_ns() - start;
+        }
+        snprintf(name, sizeof(name), "push_pop_depth_%u_ns", depth);
+        bench_record(name, (double)push_pop / cycles);
+        snprintf(name, sizeof(name), "back_home_depth_%u_ns", depth);
+        bench_record(name, (double)back_home / cycles);
+        page_manager_delete(manager);
+        harness_run(HARNESS_FRAME_MS);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    iterations = bench_init(argc, argv, 2000);
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        snprintf(page_names[i], sizeof(page_names[i]), "p%u", i);
+    }
+
+    harness_init();
+    bench_push_pop_throughput();
+    bench_anim_frame_cost();
+    bench_drag();
+    bench_page_count_scaling();
+    bench_stack_depth();
+    return bench_finish("bench_nav");
+}
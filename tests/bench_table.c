@@ -0,0 +1,239 @@
+/**
+ * 页面表基准测试,基于lvgl桩: 1024个已安装页面时按名称查找页面和遍历缓存页面的耗时,
+ * 与逐个申请页面对象、用链表串联的布局对比
+ * 命令行参数见bench_util.h
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+#include "harness.h"
+#include "page_manager_private.h"
+
+#define BENCH_PAGE_COUNT PAGE_MANAGER_PAGE_MAX
+
+/* 对照组: 每个页面单独申请,热数据和冷数据放在一起,用链表串联 */
+typedef struct bench_node_t
+{
+    struct bench_node_t *next;
+    page_base_t page;
+    uint8_t state;
+    bool is_cached;
+    bool is_busy;
+    bool is_in_stack;
+} bench_node_t;
+
+static uint32_t iterations;
+static char page_names[BENCH_PAGE_COUNT][8];
+static uint16_t lookup_order[BENCH_PAGE_COUNT];
+static page_manager_t *manager;
+static bench_node_t *node_head;
+static void *node_spacers[BENCH_PAGE_COUNT];
+
+static void bench_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void bench_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t bench_page = {
+    .on_custom_attr_config = bench_page_cfg,
+    .on_view_load = bench_page_noop,
+    .on_view_did_load = bench_page_noop,
+    .on_view_will_appear = bench_page_noop,
+    .on_view_did_appear = bench_page_noop,
+    .on_view_will_disappear = bench_page_noop,
+    .on_view_did_disappear = bench_page_noop,
+    .on_view_did_unload = bench_page_noop,
+};
+
+/**
+ * @brief 安装所有页面并逐个push/pop,使它们都成为隐藏的缓存页面
+ */
+static void bench_manager_create(void)
+{
+    manager = page_manager_create();
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_NONE, 0, lv_anim_path_linear);
+    for (uint16_t i = 0; i < BENCH_PAGE_COUNT; i++)
+    {
+        pm_install(manager, page_names[i], &bench_page);
+    }
+    pm_push(manager, page_names[0], NULL);
+    harness_run(HARNESS_FRAME_MS);
+    for (uint16_t i = 1; i < BENCH_PAGE_COUNT; i++)
+    {
+        pm_push(manager, page_names[i], NULL);
+        harness_run(HARNESS_FRAME_MS);
+        pm_pop(manager);
+        harness_run(HARNESS_FRAME_MS);
+    }
+}
+
+/**
+ * @brief 按页面表的内容建立对照组链表,节点之间夹杂其他内存块,模拟长时间运行后的堆
+ */
+static void bench_nodes_create(void)
+{
+    bench_node_t **tail = &node_head;
+    for (uint16_t i = 0; i < BENCH_PAGE_COUNT; i++)
+    {
+        page_base_t *base = &manager->page_table[i];
+        bench_node_t *node = (bench_node_t *)malloc(sizeof(bench_node_t));
+        node->next = NULL;
+        node->page = *base;
+        node->state = PAGE_HOT_STATE(base);
+        node->is_cached = PAGE_HOT_IS_CACHED(base);
+        node->is_busy = PAGE_HOT_IS_BUSY(base);
+        node->is_in_stack = PAGE_HOT_IS_IN_STACK(base);
+        *tail = node;
+        tail = &node->next;
+        node_spacers[i] = malloc(64 + (size_t)(rand() % 512));
+    }
+}
+
+static void bench_nodes_delete(void)
+{
+    for (uint16_t i = 0; i < BENCH_PAGE_COUNT; i++)
+    {
+        bench_node_t *node = node_head;
+        node_head = node->next;
+        free(node);
+        free(node_spacers[i]);
+    }
+}
+
+/**
+ * @brief 对照组: 沿链表逐个比较名称
+ */
+static bench_node_t *bench_nodes_find(const char *name)
+{
+    for (bench_node_t *node = node_head; node != NULL; node = node->next)
+    {
+        if (strcmp(node->page.name, name) == 0)
+        {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 统计隐藏的缓存页面: 只读取页面热数据数组,不访问页面表
+ */
+static uint32_t bench_table_scan(void)
+{
+    uint32_t count = 0;
+    for (uint16_t i = 0; i < BENCH_PAGE_COUNT; i++)
+    {
+        count += manager->page_hot.is_cached[i] && !manager->page_hot.is_busy[i] &&
+                 manager->page_hot.state[i] == PAGE_STATE_WILL_APPEAR;
+    }
+    return count;
+}
+
+/**
+ * @brief 对照组: 沿链表做相同的统计
+ */
+static uint32_t bench_nodes_scan(void)
+{
+    uint32_t count = 0;
+    for (bench_node_t *node = node_head; node != NULL; node = node->next)
+    {
+        count += node->is_cached && !node->is_busy && node->state == PAGE_STATE_WILL_APPEAR;
+    }
+    return count;
+}
+
+/**
+ * @brief 按名称查找页面: 哈希注册表与链表逐个比较
+ */
+static void bench_lookup(void)
+{
+    uint32_t found = 0;
+    uint64_t start = harness_now_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        for (uint16_t j = 0; j < BENCH_PAGE_COUNT; j++)
+        {
+            found += pm_get_page_id(manager, page_names[lookup_order[j]]) != PM_PAGE_ID_INVALID;
+        }
+    }
+    bench_record("lookup_table_ns", (double)(harness_now_ns() - start) / ((uint64_t)iterations * BENCH_PAGE_COUNT));
+
+    start = harness_now_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        for (uint16_t j = 0; j < BENCH_PAGE_COUNT; j++)
+        {
+            found += bench_nodes_find(page_names[lookup_order[j]]) != NULL;
+        }
+    }
+    bench_record("lookup_list_ns", (double)(harness_now_ns() - start) / ((uint64_t)iterations * BENCH_PAGE_COUNT));
+
+    if (found != 2 * iterations * BENCH_PAGE_COUNT)
+    {
+        fprintf(stderr, "bench_table: lookup failed\n");
+        exit(1);
+    }
+}
+
+/**
+ * @brief 遍历缓存页面: 页面热数据数组与对照组链表
+ *  @note 每次遍历后插入编译器屏障,防止多次遍历被合并
+ */
+static void bench_cache_scan(void)
+{
+    uint32_t scans = iterations * 10;
+    uint32_t table_count = 0;
+    uint32_t list_count = 0;
+
+    uint64_t start = harness_now_ns();
+    for (uint32_t i = 0; i < scans; i++)
+    {
+        table_count += bench_table_scan();
+        __asm__ volatile("" ::: "memory");
+    }
+    bench_record("cache_scan_table_ns", (double)(harness_now_ns() - start) / scans);
+
+    start = harness_now_ns();
+    for (uint32_t i = 0; i < scans; i++)
+    {
+        list_count += bench_nodes_scan();
+        __asm__ volatile("" ::: "memory");
+    }
+    bench_record("cache_scan_list_ns", (double)(harness_now_ns() - start) / scans);
+
+    if (table_count == 0 || table_count != list_count)
+    {
+        fprintf(stderr, "bench_table: cache scan mismatch\n");
+        exit(1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    iterations = bench_init(argc, argv, 200);
+    srand(1);
+    for (uint16_t i = 0; i < BENCH_PAGE_COUNT; i++)
+    {
+        snprintf(page_names[i], sizeof(page_names[i]), "p%u", i);
+        lookup_order[i] = (uint16_t)(rand() % BENCH_PAGE_COUNT);
+    }
+
+    harness_init();
+    bench_manager_create();
+    bench_nodes_create();
+
+    bench_lookup();
+    bench_cache_scan();
+
+    bench_nodes_delete();
+    page_manager_delete(manager);
+    harness_run(HARNESS_FRAME_MS);
+    return bench_finish("bench_table");
+}
@@ -0,0 +1,179 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+
+typedef struct
+{
+    char name[48];
+    double value;
+} bench_metric_t;
+
+static bench_metric_t metrics[BENCH_METRIC_MAX];
+static uint16_t metric_count;
+static uint32_t bench_iterations;
+static const char *out_path;
+static const char *baseline_path;
+static double threshold = 10.0;
+
+/**
+ * @brief 解析命令行,参数错误时直接退出
+ *
+ * @param argc 参数数量
+ * @param argv 参数
+ * @param iterations 默认迭代次数
+ * @return uint32_t 实际迭代次数
+ */
+uint32_t bench_init(int argc, char **argv, uint32_t iterations)
+{
+    bench_iterations = iterations;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            bench_iterations = iterations / 100 > 0 ? iterations / 100 : 1;
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            out_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+        {
+            baseline_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            threshold = strtod(argv[++i], NULL);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--out file] [--baseline file] [--threshold percent]\n", argv[0]);
+            exit(2);
+        }
+    }
+    return bench_iterations;
+}
+
+/**
+ * @brief 记录一项指标
+ *
+ * @param name 指标名称
+ * @param value 指标数值
+ */
+void bench_record(const char *name, double value)
+{
+    if (metric_count == BENCH_METRIC_MAX)
+    {
+        fprintf(stderr, "bench: too many metrics, %s dropped\n", name);
+        return;
+    }
+    snprintf(metrics[metric_count].name, sizeof(metrics[metric_count].name), "%s", name);
+    metrics[metric_count].value = value;
+    metric_count++;
+}
+
+/**
+ * @brief 以JSON格式输出结果
+ *
+ * @param fp 输出文件
+ * @param bench 基准测试名称
+ */
+static void _bench_write_json(FILE *fp, const char *bench)
+{
+    fprintf(fp, "{\n  \"bench\": \"%s\",\n  \"iterations\": %u,\n  \"metrics\": {\n", bench, (unsigned int)bench_iterations);
+    for (uint16_t i = 0; i < metric_count; i++)
+    {
+        fprintf(fp, "    \"%s\": %.2f%s\n", metrics[i].name, metrics[i].value, i + 1 < metric_count ? "," : "");
+    }
+    fprintf(fp, "  }\n}\n");
+}
+
+/**
+ * @brief 在基线JSON中查找指标
+ *
+ * @param json 基线文件内容
+ * @param name 指标名称
+ * @param value [out]基线值
+ * @return true 找到
+ */
+static bool _bench_baseline_find(const char *json, const char *name, double *value)
+{
+    char key[52];
+    snprintf(key, sizeof(key), "\"%s\"", name);
+    const char *pos = strstr(json, key);
+    if (pos == NULL || (pos = strchr(pos + strlen(key), ':')) == NULL)
+    {
+        return false;
+    }
+    *value = strtod(pos + 1, NULL);
+    return true;
+}
+
+/**
+ * @brief 与基线比较
+ *
+ * @return int 0没有退化,1有指标退化或基线无法读取
+ */
+static int _bench_compare(void)
+{
+    FILE *fp = fopen(baseline_path, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "baseline %s: cannot open\n", baseline_path);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *json = calloc(1, (size_t)size + 1);
+    size_t read_size = fread(json, 1, (size_t)size, fp);
+    json[read_size] = '\0';
+    fclose(fp);
+
+    int retval = 0;
+    fprintf(stderr, "%-32s %12s %12s %8s\n", "metric", "baseline", "current", "delta");
+    for (uint16_t i = 0; i < metric_count; i++)
+    {
+        double base;
+        if (!_bench_baseline_find(json, metrics[i].name, &base) || base <= 0)
+        {
+            fprintf(stderr, "%-32s %12s %12.2f\n", metrics[i].name, "-", metrics[i].value);
+            continue;
+        }
+        double delta = (metrics[i].value - base) * 100.0 / base;
+        bool regressed = delta > threshold;
+        fprintf(stderr, "%-32s %12.2f %12.2f %+7.1f%%%s\n", metrics[i].name, base, metrics[i].value, delta,
+                regressed ? "  REGRESSION" : "");
+        if (regressed)
+        {
+            retval = 1;
+        }
+    }
+    free(json);
+    return retval;
+}
+
+/**
+ * @brief 输出JSON结果,并与基线比较
+ *
+ * @param bench 基准测试名称
+ * @return int 进程返回值,0没有退化
+ */
+int bench_finish(const char *bench)
+{
+    _bench_write_json(stdout, bench);
+    if (out_path != NULL)
+    {
+        FILE *fp = fopen(out_path, "w");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "%s: cannot open\n", out_path);
+            return 1;
+        }
+        _bench_write_json(fp, bench);
+        fclose(fp);
+    }
+    return baseline_path != NULL ? _bench_compare() : 0;
+}
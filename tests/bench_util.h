@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* 基准测试公共部分: 命令行解析、指标记录、JSON输出和基线比较
+ *
+ * 命令行: [--quick] [--out result.json] [--baseline base.json] [--threshold 10]
+ *  --quick 迭代次数减为1/100,用于ctest冒烟测试
+ *  指定--baseline时与基线比较,任一指标变大超过阈值(百分比)返回1
+ */
+
+#define BENCH_METRIC_MAX 64
+
+    /**
+     * @brief 解析命令行,参数错误时直接退出
+     *
+     * @param argc 参数数量
+     * @param argv 参数
+     * @param iterations 默认迭代次数
+     * @return uint32_t 实际迭代次数
+     */
+    uint32_t bench_init(int argc, char **argv, uint32_t iterations);
+
+    /**
+     * @brief 记录一项指标,数值越小越好
+     *
+     * @param name 指标名称
+     * @param value 指标数值
+     */
+    void bench_record(const char *name, double value);
+
+    /**
+     * @brief 输出JSON结果,并与基线比较
+     *
+     * @param bench 基准测试名称
+     * @return int 进程返回值,0没有退化
+     */
+    int bench_finish(const char *bench);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
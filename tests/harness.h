@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#include "page_manager.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* 测试和基准测试的无界面运行环境,harness_lvgl.c基于真实lvgl,harness_stub.c基于lvgl桩 */
+
+#define HARNESS_HOR_RES 480 // 显示宽度
+#define HARNESS_VER_RES 320 // 显示高度
+#define HARNESS_FRAME_MS 10 // 每帧推进的时间
+
+    /**
+     * @brief 初始化lvgl和空帧缓冲显示驱动、指针输入设备
+     */
+    void harness_init(void);
+
+    /**
+     * @brief 推进时钟并运行lvgl任务(动画、定时任务、异步调用、刷新)
+     *
+     * @param ms 推进的时间,按HARNESS_FRAME_MS分帧
+     */
+    void harness_run(uint32_t ms);
+
+    /**
+     * @brief 获取当前屏幕上的lvgl对象数量
+     *
+     * @return uint32_t 对象数量
+     */
+    uint32_t harness_obj_count(void);
+
+    /**
+     * @brief 模拟在对象上按下、移动、松开的拖拽手势
+     *
+     * @param obj 按下的对象
+     * @param dx 水平移动距离
+     * @param dy 垂直移动距离
+     * @param steps 移动分几帧完成
+     */
+    void harness_drag(lv_obj_t *obj, lv_coord_t dx, lv_coord_t dy, uint16_t steps);
+
+    /**
+     * @brief 获取单调时钟,用于计时
+     *
+     * @return uint64_t 纳秒
+     */
+    static inline uint64_t harness_now_ns(void)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    }
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
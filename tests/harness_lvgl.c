@@ -0,0 +1,113 @@
+#include "harness.h"
+
+static lv_disp_buf_t disp_buf;
+static lv_color_t disp_buf_data[HARNESS_HOR_RES * 10];
+static lv_point_t indev_point;
+static bool indev_pressed;
+
+/**
+ * @brief 显示刷新回调,丢弃像素数据
+ *
+ * @param drv 显示驱动
+ * @param area 刷新区域
+ * @param color_p 像素数据
+ */
+static void _harness_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * @brief 指针输入设备读取回调,返回harness_drag设置的坐标和按下状态
+ *
+ * @param drv 输入设备驱动
+ * @param data 输入数据
+ * @return false 没有更多数据
+ */
+static bool _harness_indev_read_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    (void)drv;
+    data->point = indev_point;
+    data->state = indev_pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    return false;
+}
+
+/**
+ * @brief 初始化lvgl和空帧缓冲显示驱动、指针输入设备
+ */
+void harness_init(void)
+{
+    lv_init();
+
+    lv_disp_buf_init(&disp_buf, disp_buf_data, NULL, sizeof(disp_buf_data) / sizeof(disp_buf_data[0]));
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HARNESS_HOR_RES;
+    disp_drv.ver_res = HARNESS_VER_RES;
+    disp_drv.flush_cb = _harness_flush_cb;
+    disp_drv.buffer = &disp_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    lv_indev_drv_t indev_drv;
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = _harness_indev_read_cb;
+    lv_indev_drv_register(&indev_drv);
+}
+
+/**
+ * @brief 推进时钟并运行lvgl任务
+ *
+ * @param ms 推进的时间
+ */
+void harness_run(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += HARNESS_FRAME_MS)
+    {
+        lv_tick_inc(HARNESS_FRAME_MS);
+        lv_task_handler();
+    }
+}
+
+/**
+ * @brief 获取当前屏幕上的lvgl对象数量
+ *
+ * @return uint32_t 对象数量
+ */
+uint32_t harness_obj_count(void)
+{
+    return lv_obj_count_children_recursive(lv_scr_act());
+}
+
+/**
+ * @brief 模拟拖拽手势,每一步等待一个输入设备读取周期
+ *
+ * @param obj 按下的对象
+ * @param dx 水平移动距离
+ * @param dy 垂直移动距离
+ * @param steps 移动分几帧完成
+ */
+void harness_drag(lv_obj_t *obj, lv_coord_t dx, lv_coord_t dy, uint16_t steps)
+{
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_coord_t x = (area.x1 + area.x2) / 2;
+    lv_coord_t y = (area.y1 + area.y2) / 2;
+
+    indev_point.x = x;
+    indev_point.y = y;
+    indev_pressed = true;
+    harness_run(LV_INDEV_DEF_READ_PERIOD);
+
+    for (uint16_t i = 1; i <= steps; i++)
+    {
+        indev_point.x = x + (lv_coord_t)((int32_t)dx * i / steps);
+        indev_point.y = y + (lv_coord_t)((int32_t)dy * i / steps);
+        harness_run(LV_INDEV_DEF_READ_PERIOD);
+    }
+
+    indev_pressed = false;
+    harness_run(LV_INDEV_DEF_READ_PERIOD);
+}
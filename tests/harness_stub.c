@@ -0,0 +1,66 @@
+#include "harness.h"
+
+/**
+ * @brief 初始化lvgl桩,桩的显示为HARNESS_HOR_RES x HARNESS_VER_RES
+ */
+void harness_init(void)
+{
+    lv_init();
+}
+
+/**
+ * @brief 推进时钟并运行lvgl任务
+ *
+ * @param ms 推进的时间
+ */
+void harness_run(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += HARNESS_FRAME_MS)
+    {
+        lv_tick_inc(HARNESS_FRAME_MS);
+        lv_task_handler();
+    }
+}
+
+/**
+ * @brief 获取当前屏幕上的lvgl对象数量
+ *
+ * @return uint32_t 对象数量
+ */
+uint32_t harness_obj_count(void)
+{
+    return lv_obj_count_children_recursive(lv_scr_act());
+}
+
+/**
+ * @brief 模拟拖拽手势,桩没有输入设备处理,直接向对象发送按下、移动、松开事件
+ *
+ * @param obj 按下的对象
+ * @param dx 水平移动距离
+ * @param dy 垂直移动距离
+ * @param steps 移动分几帧完成
+ */
+void harness_drag(lv_obj_t *obj, lv_coord_t dx, lv_coord_t dy, uint16_t steps)
+{
+    lv_coord_t moved_x = 0;
+    lv_coord_t moved_y = 0;
+
+    lv_stub_set_indev_vect(0, 0);
+    lv_event_send(obj, LV_EVENT_PRESSED, NULL);
+    harness_run(HARNESS_FRAME_MS);
+
+    for (uint16_t i = 1; i <= steps; i++)
+    {
+        lv_coord_t x = (lv_coord_t)((int32_t)dx * i / steps);
+        lv_coord_t y = (lv_coord_t)((int32_t)dy * i / steps);
+        lv_stub_set_indev_vect(x - moved_x, y - moved_y);
+        moved_x = x;
+        moved_y = y;
+        lv_event_send(obj, LV_EVENT_PRESSING, NULL);
+        harness_run(HARNESS_FRAME_MS);
+    }
+
+    lv_stub_set_indev_vect(0, 0);
+    lv_event_send(obj, LV_EVENT_RELEASED, NULL);
+    harness_run(HARNESS_FRAME_MS);
+}
@@ -0,0 +1,612 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lvgl/lvgl.h"
+
+#define LV_STUB_ANIM_MAX 64
+#define LV_STUB_TASK_MAX 32
+#define LV_STUB_ASYNC_MAX 256
+
+typedef struct
+{
+    lv_async_cb_t cb;
+    void *user_data;
+} lv_stub_async_t;
+
+static lv_disp_t disp = {480, 320, NULL};
+static lv_indev_t indev;
+static uint32_t tick;
+static lv_anim_t anims[LV_STUB_ANIM_MAX];
+static bool anim_used[LV_STUB_ANIM_MAX];
+static lv_task_t tasks[LV_STUB_TASK_MAX];
+static lv_stub_async_t async_calls[LV_STUB_ASYNC_MAX];
+static uint16_t async_count;
+static lv_obj_t **del_queue;
+static uint32_t del_count;
+static uint32_t del_capacity;
+static uint32_t obj_count;
+static uint32_t alloc_count;
+static uint32_t anim_alloc_count;
+static uint32_t style_write_count;
+
+static void _lv_stub_fatal(const char *msg)
+{
+    fprintf(stderr, "lv_stub: %s\n", msg);
+    abort();
+}
+
+static void _lv_stub_unlink(lv_obj_t *obj)
+{
+    if (obj->parent == NULL)
+    {
+        return;
+    }
+    lv_obj_t **link = &obj->parent->child_head;
+    while (*link != NULL && *link != obj)
+    {
+        link = &(*link)->next_sib;
+    }
+    if (*link != NULL)
+    {
+        *link = obj->next_sib;
+    }
+    obj->next_sib = NULL;
+}
+
+lv_obj_t *lv_obj_create(lv_obj_t *parent, const lv_obj_t *copy)
+{
+    (void)copy;
+    lv_obj_t *obj = calloc(1, sizeof(lv_obj_t));
+    if (obj == NULL)
+    {
+        _lv_stub_fatal("out of memory");
+    }
+    obj->parent = parent;
+    obj->bg_opa = LV_OPA_COVER;
+    obj->opa_scale = LV_OPA_COVER;
+    obj->click = true;
+    if (parent != NULL)
+    {
+        obj->next_sib = parent->child_head;
+        parent->child_head = obj;
+        obj->w = parent->w;
+        obj->h = parent->h;
+    }
+    else
+    {
+        obj->w = disp.hor_res;
+        obj->h = disp.ver_res;
+    }
+    obj_count++;
+    alloc_count++;
+    return obj;
+}
+
+void lv_obj_del(lv_obj_t *obj)
+{
+    while (obj->child_head != NULL)
+    {
+        lv_obj_del(obj->child_head);
+    }
+    if (obj->event_cb != NULL)
+    {
+        obj->event_cb(obj, LV_EVENT_DELETE);
+    }
+    lv_anim_del(obj, NULL);
+    for (uint32_t i = 0; i < del_count; i++)
+    {
+        if (del_queue[i] == obj)
+        {
+            del_queue[i] = NULL;
+        }
+    }
+    _lv_stub_unlink(obj);
+    if (disp.scr_act == obj)
+    {
+        disp.scr_act = NULL;
+    }
+    free(obj);
+    obj_count--;
+}
+
+void lv_obj_del_async(lv_obj_t *obj)
+{
+    if (del_count == del_capacity)
+    {
+        del_capacity = del_capacity ? del_capacity * 2 : 64;
+        del_queue = realloc(del_queue, del_capacity * sizeof(lv_obj_t *));
+        if (del_queue == NULL)
+        {
+            _lv_stub_fatal("out of memory");
+        }
+    }
+    del_queue[del_count++] = obj;
+}
+
+lv_obj_t *lv_obj_get_parent(const lv_obj_t *obj)
+{
+    return obj->parent;
+}
+
+lv_obj_t *lv_obj_get_child(const lv_obj_t *obj, const lv_obj_t *child)
+{
+    return child != NULL ? child->next_sib : obj->child_head;
+}
+
+uint16_t lv_obj_count_children_recursive(const lv_obj_t *obj)
+{
+    uint16_t count = 0;
+    for (lv_obj_t *child = obj->child_head; child != NULL; child = child->next_sib)
+    {
+        count += 1 + lv_obj_count_children_recursive(child);
+    }
+    return count;
+}
+
+void lv_obj_move_foreground(lv_obj_t *obj)
+{
+    lv_obj_t *parent = obj->parent;
+    if (parent == NULL || parent->child_head == obj)
+    {
+        return;
+    }
+    _lv_stub_unlink(obj);
+    obj->next_sib = parent->child_head;
+    parent->child_head = obj;
+}
+
+void lv_obj_move_background(lv_obj_t *obj)
+{
+    lv_obj_t *parent = obj->parent;
+    if (parent == NULL)
+    {
+        return;
+    }
+    _lv_stub_unlink(obj);
+    lv_obj_t **link = &parent->child_head;
+    while (*link != NULL)
+    {
+        link = &(*link)->next_sib;
+    }
+    obj->next_sib = NULL;
+    *link = obj;
+}
+
+void lv_obj_set_pos(lv_obj_t *obj, lv_coord_t x, lv_coord_t y)
+{
+    obj->x = x;
+    obj->y = y;
+}
+
+void lv_obj_set_x(lv_obj_t *obj, lv_coord_t x)
+{
+    obj->x = x;
+}
+
+void lv_obj_set_y(lv_obj_t *obj, lv_coord_t y)
+{
+    obj->y = y;
+}
+
+void lv_obj_set_size(lv_obj_t *obj, lv_coord_t w, lv_coord_t h)
+{
+    obj->w = w;
+    obj->h = h;
+}
+
+lv_coord_t lv_obj_get_x(const lv_obj_t *obj)
+{
+    return obj->x;
+}
+
+lv_coord_t lv_obj_get_y(const lv_obj_t *obj)
+{
+    return obj->y;
+}
+
+lv_coord_t lv_obj_get_width(const lv_obj_t *obj)
+{
+    return obj->w;
+}
+
+lv_coord_t lv_obj_get_height(const lv_obj_t *obj)
+{
+    return obj->h;
+}
+
+void lv_obj_get_coords(const lv_obj_t *obj, lv_area_t *area)
+{
+    area->x1 = obj->x;
+    area->y1 = obj->y;
+    for (const lv_obj_t *parent = obj->parent; parent != NULL; parent = parent->parent)
+    {
+        area->x1 += parent->x;
+        area->y1 += parent->y;
+    }
+    area->x2 = area->x1 + obj->w - 1;
+    area->y2 = area->y1 + obj->h - 1;
+}
+
+void lv_obj_set_hidden(lv_obj_t *obj, bool en)
+{
+    obj->hidden = en;
+}
+
+bool lv_obj_get_hidden(const lv_obj_t *obj)
+{
+    return obj->hidden;
+}
+
+void lv_obj_set_click(lv_obj_t *obj, bool en)
+{
+    obj->click = en;
+}
+
+void lv_obj_invalidate(const lv_obj_t *obj)
+{
+    (void)obj;
+}
+
+void lv_obj_set_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb)
+{
+    obj->event_cb = event_cb;
+}
+
+void *lv_obj_get_user_data(const lv_obj_t *obj)
+{
+    return obj->user_data;
+}
+
+lv_disp_t *lv_obj_get_disp(const lv_obj_t *obj)
+{
+    (void)obj;
+    return &disp;
+}
+
+lv_res_t lv_event_send(lv_obj_t *obj, lv_event_t event, const void *data)
+{
+    (void)data;
+    if (obj->event_cb != NULL)
+    {
+        obj->event_cb(obj, event);
+    }
+    return LV_RES_OK;
+}
+
+void lv_obj_set_style_local_bg_opa(lv_obj_t *obj, uint8_t part, lv_state_t state, lv_opa_t value)
+{
+    (void)part;
+    (void)state;
+    obj->bg_opa = value;
+    style_write_count++;
+}
+
+void lv_obj_set_style_local_opa_scale(lv_obj_t *obj, uint8_t part, lv_state_t state, lv_opa_t value)
+{
+    (void)part;
+    (void)state;
+    obj->opa_scale = value;
+    style_write_count++;
+}
+
+bool lv_obj_remove_style_local_prop(lv_obj_t *obj, uint8_t part, lv_style_property_t prop)
+{
+    (void)part;
+    if (prop == LV_STYLE_OPA_SCALE)
+    {
+        obj->opa_scale = LV_OPA_COVER;
+    }
+    else if (prop == LV_STYLE_BG_OPA)
+    {
+        obj->bg_opa = LV_OPA_COVER;
+    }
+    style_write_count++;
+    return true;
+}
+
+lv_opa_t lv_obj_get_style_bg_opa(const lv_obj_t *obj, uint8_t part)
+{
+    (void)part;
+    return obj->bg_opa;
+}
+
+lv_opa_t lv_obj_get_style_opa_scale(const lv_obj_t *obj, uint8_t part)
+{
+    (void)part;
+    return obj->opa_scale;
+}
+
+lv_disp_t *lv_disp_get_default(void)
+{
+    return &disp;
+}
+
+lv_disp_t *lv_disp_get_next(lv_disp_t *d)
+{
+    return d == NULL ? &disp : NULL;
+}
+
+lv_obj_t *lv_disp_get_scr_act(lv_disp_t *d)
+{
+    if (d == NULL)
+    {
+        d = &disp;
+    }
+    if (d->scr_act == NULL)
+    {
+        d->scr_act = lv_obj_create(NULL, NULL);
+    }
+    return d->scr_act;
+}
+
+lv_coord_t lv_disp_get_hor_res(lv_disp_t *d)
+{
+    return d != NULL ? d->hor_res : disp.hor_res;
+}
+
+lv_coord_t lv_disp_get_ver_res(lv_disp_t *d)
+{
+    return d != NULL ? d->ver_res : disp.ver_res;
+}
+
+lv_obj_t *lv_scr_act(void)
+{
+    return lv_disp_get_scr_act(&disp);
+}
+
+lv_indev_t *lv_indev_get_act(void)
+{
+    return &indev;
+}
+
+void lv_indev_get_vect(const lv_indev_t *in, lv_point_t *point)
+{
+    *point = in->vect;
+}
+
+void lv_anim_init(lv_anim_t *a)
+{
+    memset(a, 0, sizeof(lv_anim_t));
+    a->time = 500;
+}
+
+void lv_anim_start(lv_anim_t *a)
+{
+    lv_anim_del(a->var, a->exec_cb);
+    // lvgl v7在动画链表头插入新节点(_lv_ll_ins_head -> lv_mem_alloc),桩按一次申请计数
+    alloc_count++;
+    anim_alloc_count++;
+    for (uint8_t i = 0; i < LV_STUB_ANIM_MAX; i++)
+    {
+        if (!anim_used[i])
+        {
+            anims[i] = *a;
+            anims[i].act_time = 0;
+            anims[i].last_tick = tick;
+            anim_used[i] = true;
+            if (a->exec_cb != NULL)
+            {
+                a->exec_cb(a->var, (lv_anim_value_t)a->start);
+            }
+            return;
+        }
+    }
+    _lv_stub_fatal("too many animations");
+}
+
+bool lv_anim_del(void *var, lv_anim_exec_xcb_t exec_cb)
+{
+    bool deleted = false;
+    for (uint8_t i = 0; i < LV_STUB_ANIM_MAX; i++)
+    {
+        if (anim_used[i] && anims[i].var == var && (exec_cb == NULL || anims[i].exec_cb == exec_cb))
+        {
+            anim_used[i] = false;
+            deleted = true;
+        }
+    }
+    return deleted;
+}
+
+lv_anim_t *lv_anim_get(void *var, lv_anim_exec_xcb_t exec_cb)
+{
+    for (uint8_t i = 0; i < LV_STUB_ANIM_MAX; i++)
+    {
+        if (anim_used[i] && anims[i].var == var && (exec_cb == NULL || anims[i].exec_cb == exec_cb))
+        {
+            return &anims[i];
+        }
+    }
+    return NULL;
+}
+
+lv_anim_value_t lv_anim_path_linear(const lv_anim_path_t *path, const lv_anim_t *a)
+{
+    (void)path;
+    if (a->time <= 0)
+    {
+        return (lv_anim_value_t)a->end;
+    }
+    int32_t act_time = a->act_time > a->time ? a->time : a->act_time;
+    return (lv_anim_value_t)(a->start + (a->end - a->start) * act_time / a->time);
+}
+
+lv_anim_value_t lv_anim_path_overshoot(const lv_anim_path_t *path, const lv_anim_t *a)
+{
+    return lv_anim_path_linear(path, a);
+}
+
+lv_task_t *lv_task_create(lv_task_cb_t task_cb, uint32_t period, lv_task_prio_t prio, void *user_data)
+{
+    for (uint8_t i = 0; i < LV_STUB_TASK_MAX; i++)
+    {
+        if (!tasks[i].used)
+        {
+            tasks[i].period = period;
+            tasks[i].last_run = tick;
+            tasks[i].task_cb = task_cb;
+            tasks[i].user_data = user_data;
+            tasks[i].prio = prio;
+            tasks[i].used = true;
+            return &tasks[i];
+        }
+    }
+    _lv_stub_fatal("too many tasks");
+    return NULL;
+}
+
+void lv_task_del(lv_task_t *task)
+{
+    task->used = false;
+}
+
+void lv_task_set_prio(lv_task_t *task, lv_task_prio_t prio)
+{
+    task->prio = prio;
+}
+
+/**
+ * @brief 依次推进动画、运行到期的定时任务、执行异步调用和异步删除
+ */
+uint32_t lv_task_handler(void)
+{
+    for (uint8_t i = 0; i < LV_STUB_ANIM_MAX; i++)
+    {
+        if (!anim_used[i])
+        {
+            continue;
+        }
+        lv_anim_t *a = &anims[i];
+        a->act_time += (int32_t)(tick - a->last_tick);
+        a->last_tick = tick;
+        lv_anim_value_t value = a->path.cb != NULL ? a->path.cb(&a->path, a) : lv_anim_path_linear(NULL, a);
+        if (a->exec_cb != NULL)
+        {
+            a->exec_cb(a->var, value);
+        }
+        if (anim_used[i] && a->act_time >= a->time)
+        {
+            lv_anim_t ready = *a;
+            anim_used[i] = false;
+            if (ready.ready_cb != NULL)
+            {
+                ready.ready_cb(&ready);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < LV_STUB_TASK_MAX; i++)
+    {
+        if (tasks[i].used && tasks[i].prio != LV_TASK_PRIO_OFF && tick - tasks[i].last_run >= tasks[i].period)
+        {
+            tasks[i].last_run = tick;
+            tasks[i].task_cb(&tasks[i]);
+        }
+    }
+
+    uint16_t count = async_count;
+    async_count = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        async_calls[i].cb(async_calls[i].user_data);
+    }
+
+    while (del_count > 0)
+    {
+        lv_obj_t *obj = del_queue[--del_count];
+        if (obj != NULL)
+        {
+            lv_obj_del(obj);
+        }
+    }
+    return 1;
+}
+
+lv_res_t lv_async_call(lv_async_cb_t async_xcb, void *user_data)
+{
+    if (async_count == LV_STUB_ASYNC_MAX)
+    {
+        _lv_stub_fatal("too many async calls");
+    }
+    async_calls[async_count].cb = async_xcb;
+    async_calls[async_count].user_data = user_data;
+    async_count++;
+    return LV_RES_OK;
+}
+
+void lv_init(void)
+{
+}
+
+void lv_tick_inc(uint32_t tick_period)
+{
+    tick += tick_period;
+}
+
+uint32_t lv_tick_get(void)
+{
+    return tick;
+}
+
+uint32_t lv_tick_elaps(uint32_t prev_tick)
+{
+    return tick - prev_tick;
+}
+
+void *lv_mem_alloc(size_t size)
+{
+    alloc_count++;
+    return malloc(size);
+}
+
+void lv_mem_free(const void *data)
+{
+    free((void *)data);
+}
+
+void *lv_mem_realloc(void *data_p, size_t new_size)
+{
+    alloc_count++;
+    return realloc(data_p, new_size);
+}
+
+void lv_mem_monitor(lv_mem_monitor_t *mon_p)
+{
+    memset(mon_p, 0, sizeof(lv_mem_monitor_t));
+}
+
+void lv_stub_set_indev_vect(lv_coord_t x, lv_coord_t y)
+{
+    indev.vect.x = x;
+    indev.vect.y = y;
+}
+
+uint32_t lv_stub_obj_count(void)
+{
+    return obj_count;
+}
+
+uint32_t lv_stub_anim_count(void)
+{
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < LV_STUB_ANIM_MAX; i++)
+    {
+        count += anim_used[i];
+    }
+    return count;
+}
+
+uint32_t lv_stub_alloc_count(void)
+{
+    return alloc_count;
+}
+
+uint32_t lv_stub_anim_alloc_count(void)
+{
+    return anim_alloc_count;
+}
+
+uint32_t lv_stub_style_write_count(void)
+{
+    return style_write_count;
+}
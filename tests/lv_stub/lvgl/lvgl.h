@@ -0,0 +1,308 @@
+/**
+ * lvgl v7接口桩,只实现页面管理器和测试用到的部分
+ *
+ * 对象只记录位置、大小、隐藏和少量样式,不绘制;动画按线性插值推进;
+ * 定时任务、异步调用和异步删除在lv_task_handler()中执行。
+ * 末尾的lv_stub_*接口供测试注入输入和读取计数。
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define LVGL_VERSION_MAJOR 7
+#define LVGL_VERSION_MINOR 11
+
+    typedef int16_t lv_coord_t;
+    typedef uint8_t lv_opa_t;
+    typedef uint8_t lv_event_t;
+    typedef uint8_t lv_state_t;
+    typedef uint16_t lv_style_property_t;
+    typedef int16_t lv_anim_value_t;
+
+    typedef struct
+    {
+        lv_coord_t x;
+        lv_coord_t y;
+    } lv_point_t;
+
+    typedef struct
+    {
+        lv_coord_t x1;
+        lv_coord_t y1;
+        lv_coord_t x2;
+        lv_coord_t y2;
+    } lv_area_t;
+
+    enum
+    {
+        LV_OPA_TRANSP = 0,
+        LV_OPA_50 = 127,
+        LV_OPA_COVER = 255,
+    };
+
+    enum
+    {
+        LV_EVENT_PRESSED,
+        LV_EVENT_PRESSING,
+        LV_EVENT_PRESS_LOST,
+        LV_EVENT_SHORT_CLICKED,
+        LV_EVENT_LONG_PRESSED,
+        LV_EVENT_LONG_PRESSED_REPEAT,
+        LV_EVENT_CLICKED,
+        LV_EVENT_RELEASED,
+        LV_EVENT_DRAG_BEGIN,
+        LV_EVENT_DRAG_END,
+        LV_EVENT_DRAG_THROW_BEGIN,
+        LV_EVENT_GESTURE,
+        LV_EVENT_KEY,
+        LV_EVENT_FOCUSED,
+        LV_EVENT_DEFOCUSED,
+        LV_EVENT_LEAVE,
+        LV_EVENT_VALUE_CHANGED,
+        LV_EVENT_INSERT,
+        LV_EVENT_REFRESH,
+        LV_EVENT_APPLY,
+        LV_EVENT_CANCEL,
+        LV_EVENT_DELETE,
+    };
+
+    typedef enum
+    {
+        LV_RES_INV = 0,
+        LV_RES_OK,
+    } lv_res_t;
+
+#define LV_OBJ_PART_MAIN 0
+#define LV_STATE_DEFAULT 0
+#define LV_STYLE_BG_OPA 0x002C
+#define LV_STYLE_OPA_SCALE 0x800C
+
+    struct _lv_obj_t;
+    typedef void (*lv_event_cb_t)(struct _lv_obj_t *obj, lv_event_t event);
+
+    typedef struct _lv_obj_t
+    {
+        struct _lv_obj_t *parent;
+        struct _lv_obj_t *child_head; // 第一个子对象在最前面
+        struct _lv_obj_t *next_sib;
+        lv_coord_t x;
+        lv_coord_t y;
+        lv_coord_t w;
+        lv_coord_t h;
+        lv_opa_t bg_opa;
+        lv_opa_t opa_scale;
+        bool hidden;
+        bool click;
+        lv_event_cb_t event_cb;
+        void *user_data;
+    } lv_obj_t;
+
+    typedef struct _lv_disp_t
+    {
+        lv_coord_t hor_res;
+        lv_coord_t ver_res;
+        lv_obj_t *scr_act;
+    } lv_disp_t;
+
+    typedef struct
+    {
+        lv_point_t vect;
+    } lv_indev_t;
+
+    /* 对象 */
+    lv_obj_t *lv_obj_create(lv_obj_t *parent, const lv_obj_t *copy);
+    void lv_obj_del(lv_obj_t *obj);
+    void lv_obj_del_async(lv_obj_t *obj);
+    lv_obj_t *lv_obj_get_parent(const lv_obj_t *obj);
+    lv_obj_t *lv_obj_get_child(const lv_obj_t *obj, const lv_obj_t *child);
+    uint16_t lv_obj_count_children_recursive(const lv_obj_t *obj);
+    void lv_obj_move_foreground(lv_obj_t *obj);
+    void lv_obj_move_background(lv_obj_t *obj);
+    void lv_obj_set_pos(lv_obj_t *obj, lv_coord_t x, lv_coord_t y);
+    void lv_obj_set_x(lv_obj_t *obj, lv_coord_t x);
+    void lv_obj_set_y(lv_obj_t *obj, lv_coord_t y);
+    void lv_obj_set_size(lv_obj_t *obj, lv_coord_t w, lv_coord_t h);
+    lv_coord_t lv_obj_get_x(const lv_obj_t *obj);
+    lv_coord_t lv_obj_get_y(const lv_obj_t *obj);
+    lv_coord_t lv_obj_get_width(const lv_obj_t *obj);
+    lv_coord_t lv_obj_get_height(const lv_obj_t *obj);
+    void lv_obj_get_coords(const lv_obj_t *obj, lv_area_t *area);
+    void lv_obj_set_hidden(lv_obj_t *obj, bool en);
+    bool lv_obj_get_hidden(const lv_obj_t *obj);
+    void lv_obj_set_click(lv_obj_t *obj, bool en);
+    void lv_obj_invalidate(const lv_obj_t *obj);
+    void lv_obj_set_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb);
+    void *lv_obj_get_user_data(const lv_obj_t *obj);
+    lv_disp_t *lv_obj_get_disp(const lv_obj_t *obj);
+    lv_res_t lv_event_send(lv_obj_t *obj, lv_event_t event, const void *data);
+
+    /* 样式,每次写入计入lv_stub_style_write_count() */
+    void lv_obj_set_style_local_bg_opa(lv_obj_t *obj, uint8_t part, lv_state_t state, lv_opa_t value);
+    void lv_obj_set_style_local_opa_scale(lv_obj_t *obj, uint8_t part, lv_state_t state, lv_opa_t value);
+    bool lv_obj_remove_style_local_prop(lv_obj_t *obj, uint8_t part, lv_style_property_t prop);
+    lv_opa_t lv_obj_get_style_bg_opa(const lv_obj_t *obj, uint8_t part);
+    lv_opa_t lv_obj_get_style_opa_scale(const lv_obj_t *obj, uint8_t part);
+
+    /* 显示 */
+    lv_disp_t *lv_disp_get_default(void);
+    lv_disp_t *lv_disp_get_next(lv_disp_t *disp);
+    lv_obj_t *lv_disp_get_scr_act(lv_disp_t *disp);
+    lv_coord_t lv_disp_get_hor_res(lv_disp_t *disp);
+    lv_coord_t lv_disp_get_ver_res(lv_disp_t *disp);
+    lv_obj_t *lv_scr_act(void);
+#define LV_HOR_RES lv_disp_get_hor_res(lv_disp_get_default())
+#define LV_VER_RES lv_disp_get_ver_res(lv_disp_get_default())
+
+    /* 输入设备 */
+    lv_indev_t *lv_indev_get_act(void);
+    void lv_indev_get_vect(const lv_indev_t *indev, lv_point_t *point);
+
+    /* 动画 */
+    struct _lv_anim_t;
+    struct _lv_anim_path_t;
+    typedef lv_anim_value_t (*lv_anim_path_cb_t)(const struct _lv_anim_path_t *, const struct _lv_anim_t *);
+    typedef void (*lv_anim_exec_xcb_t)(void *, lv_anim_value_t);
+    typedef void (*lv_anim_ready_cb_t)(struct _lv_anim_t *);
+
+    typedef struct _lv_anim_path_t
+    {
+        lv_anim_path_cb_t cb;
+        void *user_data;
+    } lv_anim_path_t;
+
+    typedef struct _lv_anim_t
+    {
+        void *var;
+        lv_anim_exec_xcb_t exec_cb;
+        lv_anim_ready_cb_t ready_cb;
+        lv_anim_path_t path;
+        int32_t start;
+        int32_t current;
+        int32_t end;
+        int32_t time;
+        int32_t act_time;
+        uint32_t last_tick; // 桩: 上一次推进动画时的时钟
+        void *user_data;
+    } lv_anim_t;
+
+    void lv_anim_init(lv_anim_t *a);
+    void lv_anim_start(lv_anim_t *a);
+    bool lv_anim_del(void *var, lv_anim_exec_xcb_t exec_cb);
+    lv_anim_t *lv_anim_get(void *var, lv_anim_exec_xcb_t exec_cb);
+    lv_anim_value_t lv_anim_path_linear(const lv_anim_path_t *path, const lv_anim_t *a);
+    lv_anim_value_t lv_anim_path_overshoot(const lv_anim_path_t *path, const lv_anim_t *a);
+
+    static inline void lv_anim_set_var(lv_anim_t *a, void *var)
+    {
+        a->var = var;
+    }
+
+    static inline void lv_anim_set_exec_cb(lv_anim_t *a, lv_anim_exec_xcb_t exec_cb)
+    {
+        a->exec_cb = exec_cb;
+    }
+
+    static inline void lv_anim_set_time(lv_anim_t *a, uint32_t duration)
+    {
+        a->time = (int32_t)duration;
+    }
+
+    static inline void lv_anim_set_values(lv_anim_t *a, lv_anim_value_t start, lv_anim_value_t end)
+    {
+        a->start = start;
+        a->current = start;
+        a->end = end;
+    }
+
+    static inline void lv_anim_set_ready_cb(lv_anim_t *a, lv_anim_ready_cb_t ready_cb)
+    {
+        a->ready_cb = ready_cb;
+    }
+
+    static inline void lv_anim_path_init(lv_anim_path_t *path)
+    {
+        memset(path, 0, sizeof(lv_anim_path_t));
+    }
+
+    static inline void lv_anim_path_set_cb(lv_anim_path_t *path, lv_anim_path_cb_t cb)
+    {
+        path->cb = cb;
+    }
+
+    static inline void lv_anim_set_path(lv_anim_t *a, const lv_anim_path_t *path)
+    {
+        a->path = *path;
+    }
+
+    /* 定时任务和异步调用 */
+    struct _lv_task_t;
+    typedef void (*lv_task_cb_t)(struct _lv_task_t *);
+    typedef void (*lv_async_cb_t)(void *);
+
+    typedef enum
+    {
+        LV_TASK_PRIO_OFF = 0,
+        LV_TASK_PRIO_LOWEST,
+        LV_TASK_PRIO_LOW,
+        LV_TASK_PRIO_MID,
+        LV_TASK_PRIO_HIGH,
+        LV_TASK_PRIO_HIGHEST,
+    } lv_task_prio_t;
+
+    typedef struct _lv_task_t
+    {
+        uint32_t period;
+        uint32_t last_run;
+        lv_task_cb_t task_cb;
+        void *user_data;
+        lv_task_prio_t prio;
+        bool used;
+    } lv_task_t;
+
+    lv_task_t *lv_task_create(lv_task_cb_t task_cb, uint32_t period, lv_task_prio_t prio, void *user_data);
+    void lv_task_del(lv_task_t *task);
+    void lv_task_set_prio(lv_task_t *task, lv_task_prio_t prio);
+    uint32_t lv_task_handler(void);
+    lv_res_t lv_async_call(lv_async_cb_t async_xcb, void *user_data);
+
+    /* 时钟和内存 */
+    typedef struct
+    {
+        uint32_t total_size;
+        uint32_t free_cnt;
+        uint32_t free_size;
+        uint32_t free_biggest_size;
+        uint32_t used_cnt;
+        uint32_t max_used;
+        uint8_t used_pct;
+        uint8_t frag_pct;
+    } lv_mem_monitor_t;
+
+    void lv_init(void);
+    void lv_tick_inc(uint32_t tick_period);
+    uint32_t lv_tick_get(void);
+    uint32_t lv_tick_elaps(uint32_t prev_tick);
+    void *lv_mem_alloc(size_t size);
+    void lv_mem_free(const void *data);
+    void *lv_mem_realloc(void *data_p, size_t new_size);
+    void lv_mem_monitor(lv_mem_monitor_t *mon_p);
+
+    /* 桩控制接口 */
+    void lv_stub_set_indev_vect(lv_coord_t x, lv_coord_t y); // 设置下一次lv_indev_get_vect()的返回值
+    uint32_t lv_stub_obj_count(void);                         // 未删除的对象数量,包括屏幕
+    uint32_t lv_stub_anim_count(void);                        // 正在播放的动画数量
+    uint32_t lv_stub_alloc_count(void);                       // 累计申请次数,包括对象、lv_mem和动画节点
+    uint32_t lv_stub_anim_alloc_count(void);                  // 累计的动画节点申请次数,每次lv_anim_start一次
+    uint32_t lv_stub_style_write_count(void);                 // 累计样式写入次数
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,108 @@
+/**
+ * 内存申请测试: 预热后在缓存页面之间反复切换,页面管理器不应再申请内存,lvgl只申请动画节点
+ */
+#include "harness.h"
+#include "test_util.h"
+
+#define ALLOC_CYCLES 200
+
+static void test_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void test_page_load(page_base_t *self)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        lv_obj_create(self->root, NULL);
+    }
+}
+
+static void test_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t test_page = {
+    test_page_cfg, test_page_load, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+/**
+ * @brief 一次push/pop/replace循环,push带内联和内存池大小的数据块
+ *
+ * @param manager 页面管理器对象
+ * @param stash_small 内联存储的数据块
+ * @param stash_large 内存池存储的数据块
+ */
+static void test_cycle(page_manager_t *manager, const page_stash_t *stash_small, const page_stash_t *stash_large)
+{
+    pm_push(manager, "a", stash_small);
+    harness_run(300);
+    pm_push(manager, "b", stash_large);
+    harness_run(300);
+    pm_replace(manager, "c", stash_small);
+    harness_run(300);
+    pm_pop(manager);
+    harness_run(300);
+    pm_pop(manager);
+    harness_run(300);
+}
+
+/* 预热后缓存页面之间的稳态切换不申请内存 */
+static void test_steady_state(uint8_t anim)
+{
+    uint8_t small[4] = {1, 2, 3, 4};
+    uint8_t large[200] = {0};
+    page_stash_t stash_small = {small, sizeof(small)};
+    page_stash_t stash_large = {large, sizeof(large)};
+
+    page_manager_t *manager = page_manager_create();
+    pm_install(manager, "home", &test_page);
+    pm_install(manager, "a", &test_page);
+    pm_install(manager, "b", &test_page);
+    pm_install(manager, "c", &test_page);
+    pm_set_global_load_anim_type(manager, anim, 200, lv_anim_path_linear);
+    pm_push(manager, "home", NULL);
+    harness_run(300);
+
+    /* 预热: 所有页面都已构建并缓存,数据块内存池已有存储区 */
+    test_cycle(manager, &stash_small, &stash_large);
+    test_cycle(manager, &stash_small, &stash_large);
+
+    pm_alloc_stat_t before;
+    pm_get_alloc_stat(manager, &before);
+    uint32_t lv_allocs = lv_stub_alloc_count();
+    uint32_t lv_anim_allocs = lv_stub_anim_alloc_count();
+    pm_set_alloc_locked(manager, true);
+
+    for (int i = 0; i < ALLOC_CYCLES; i++)
+    {
+        test_cycle(manager, &stash_small, &stash_large);
+    }
+
+    pm_alloc_stat_t after;
+    pm_get_alloc_stat(manager, &after);
+    TEST_CHECK(after.alloc_count == before.alloc_count);
+    TEST_CHECK(after.free_count == before.free_count);
+    TEST_CHECK(after.bytes_peak == before.bytes_peak);
+    TEST_CHECK(after.locked_alloc_count == 0);
+    // lvgl每次lv_anim_start都在自己的堆上申请动画节点,是允许的例外,其他lvgl申请(对象、lv_mem)不允许
+    uint32_t anim_allocs = lv_stub_anim_alloc_count() - lv_anim_allocs;
+    TEST_CHECK(lv_stub_alloc_count() - lv_allocs == anim_allocs);
+    printf("anim %d: %.1f lvgl anim node allocs per cycle\n", anim, (double)anim_allocs / ALLOC_CYCLES);
+
+    pm_set_alloc_locked(manager, false);
+    page_manager_delete(manager);
+    harness_run(100);
+}
+
+int main(void)
+{
+    harness_init();
+    test_steady_state(LOAD_ANIM_OVER_LEFT);
+    test_steady_state(LOAD_ANIM_FADE_ON);
+    test_steady_state(LOAD_ANIM_NONE);
+    return TEST_RESULT();
+}
@@ -0,0 +1,75 @@
+/**
+ * 动画类型注册表测试: 注册时校验描述,拖拽和快照在没有setter/getter的动画类型下不调用它们
+ */
+#include "harness.h"
+#include "page_manager_private.h"
+#include "test_util.h"
+
+static void test_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void test_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t test_page = {
+    test_page_cfg, test_page_noop, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+static void test_setter(void *obj, int16_t v)
+{
+    lv_obj_set_x((lv_obj_t *)obj, v);
+}
+
+static int32_t test_getter(void *obj)
+{
+    return lv_obj_get_x((lv_obj_t *)obj);
+}
+
+static void test_register(page_manager_t *manager)
+{
+    pm_anim_type_t no_getter = {.setter = test_setter};
+    pm_anim_type_t no_setter = {.getter = test_getter};
+    pm_anim_type_t valid = {.setter = test_setter, .getter = test_getter, .drag_dir = ROOT_DRAG_DIR_HOR};
+
+    TEST_CHECK(pm_register_anim_type(manager, NULL) == LOAD_ANIM_GLOBAL);
+    TEST_CHECK(pm_register_anim_type(manager, &no_getter) == LOAD_ANIM_GLOBAL);
+    TEST_CHECK(pm_register_anim_type(manager, &no_setter) == LOAD_ANIM_GLOBAL);
+    TEST_CHECK(pm_register_anim_type(manager, &valid) > _LOAD_ANIM_LAST);
+}
+
+/* 拖拽开启后全局动画改成LOAD_ANIM_NONE,再拖拽不应调用空的getter/setter */
+static void test_drag_after_anim_none(page_manager_t *manager)
+{
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, 100, lv_anim_path_linear);
+    pm_push(manager, "a", NULL);
+    harness_run(200);
+    pm_push(manager, "b", NULL);
+    harness_run(200);
+    lv_obj_t *root = manager->stack_top->root;
+
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_NONE, 100, lv_anim_path_linear);
+    harness_drag(root, HARNESS_HOR_RES / 4, 0, 5);
+    harness_run(200);
+    TEST_CHECK(lv_obj_get_x(root) == 0);
+    TEST_CHECK(manager->stack_top->root == root);
+}
+
+int main(void)
+{
+    harness_init();
+    page_manager_t *manager = page_manager_create();
+    pm_install(manager, "a", &test_page);
+    pm_install(manager, "b", &test_page);
+
+    test_register(manager);
+    test_drag_after_anim_none(manager);
+
+    page_manager_delete(manager);
+    harness_run(100);
+    return TEST_RESULT();
+}
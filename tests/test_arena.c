@@ -0,0 +1,193 @@
+/**
+ * 内存池测试: 释放的块可以被再次申请,相邻的空闲块合并,全部释放后内存池回到初始状态;
+ * 页面管理器可以绑定到容器并使用内存池
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "harness.h"
+#include "test_util.h"
+
+#define ARENA_SIZE (512 * 1024)
+#define ARENA_SLOTS 64
+
+static uint8_t arena_buf[ARENA_SIZE];
+
+/* 释放中间的块后,不超过其大小的申请复用该块 */
+static void test_reuse(void)
+{
+    pm_arena_t arena;
+    pm_allocator_t allocator;
+    pm_arena_init(&arena, arena_buf, sizeof(arena_buf), &allocator);
+
+    void *a = allocator.alloc(allocator.ctx, 100);
+    void *b = allocator.alloc(allocator.ctx, 200);
+    void *c = allocator.alloc(allocator.ctx, 100);
+    size_t used = arena.used;
+
+    allocator.free(allocator.ctx, b);
+    TEST_CHECK(arena.used == used);
+    void *d = allocator.alloc(allocator.ctx, 64);
+    TEST_CHECK(d == b);
+    void *e = allocator.alloc(allocator.ctx, 64);
+    TEST_CHECK((uint8_t *)e > (uint8_t *)d && (uint8_t *)e < (uint8_t *)c);
+    TEST_CHECK(arena.used == used);
+
+    allocator.free(allocator.ctx, d);
+    allocator.free(allocator.ctx, e);
+    allocator.free(allocator.ctx, a);
+    void *f = allocator.alloc(allocator.ctx, 300);
+    TEST_CHECK(f == a);
+    allocator.free(allocator.ctx, f);
+
+    allocator.free(allocator.ctx, c);
+    TEST_CHECK(arena.used == 0);
+    TEST_CHECK(arena.free_list == NULL);
+}
+
+/* realloc(NULL, n)等同于申请 */
+static void test_realloc_null(void)
+{
+    pm_arena_t arena;
+    pm_allocator_t allocator;
+    pm_arena_init(&arena, arena_buf, sizeof(arena_buf), &allocator);
+
+    void *a = allocator.realloc(allocator.ctx, NULL, 100);
+    TEST_CHECK(a != NULL);
+    TEST_CHECK(arena.used > 0);
+    memset(a, 0x5a, 100);
+    allocator.free(allocator.ctx, a);
+    TEST_CHECK(arena.used == 0);
+}
+
+/* 随机申请、重新申请和释放,数据保持不变,全部释放后内存池为空 */
+static void test_random(void)
+{
+    pm_arena_t arena;
+    pm_allocator_t allocator;
+    pm_arena_init(&arena, arena_buf, sizeof(arena_buf), &allocator);
+
+    uint8_t *slots[ARENA_SLOTS] = {0};
+    size_t sizes[ARENA_SLOTS] = {0};
+    srand(1);
+
+    for (int i = 0; i < 100000; i++)
+    {
+        int n = rand() % ARENA_SLOTS;
+        if (slots[n] != NULL)
+        {
+            for (size_t j = 0; j < sizes[n]; j++)
+            {
+                if (slots[n][j] != (uint8_t)(n + j))
+                {
+                    TEST_CHECK(slots[n][j] == (uint8_t)(n + j));
+                    return;
+                }
+            }
+        }
+
+        size_t size = (size_t)(rand() % 400);
+        if (slots[n] == NULL)
+        {
+            slots[n] = (uint8_t *)allocator.alloc(allocator.ctx, size);
+        }
+        else if (rand() % 2)
+        {
+            uint8_t *ptr = (uint8_t *)allocator.realloc(allocator.ctx, slots[n], size);
+            if (ptr == NULL)
+            {
+                continue;
+            }
+            // 保留的数据在下一次访问时检查
+            slots[n] = ptr;
+            sizes[n] = size < sizes[n] ? size : sizes[n];
+            continue;
+        }
+        else
+        {
+            allocator.free(allocator.ctx, slots[n]);
+            slots[n] = NULL;
+            continue;
+        }
+
+        if (slots[n] != NULL)
+        {
+            sizes[n] = size;
+            for (size_t j = 0; j < size; j++)
+            {
+                slots[n][j] = (uint8_t)(n + j);
+            }
+        }
+    }
+
+    for (int n = 0; n < ARENA_SLOTS; n++)
+    {
+        if (slots[n] != NULL)
+        {
+            allocator.free(allocator.ctx, slots[n]);
+        }
+    }
+    TEST_CHECK(arena.used == 0);
+    TEST_CHECK(arena.free_list == NULL);
+}
+
+static void test_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void test_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t test_page = {
+    test_page_cfg, test_page_noop, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+/* 绑定到容器的页面管理器从内存池申请,带数据块导航后删除,内存池回到初始状态 */
+static void test_manager_on_arena(void)
+{
+    pm_arena_t arena;
+    pm_allocator_t allocator;
+    pm_arena_init(&arena, arena_buf, sizeof(arena_buf), &allocator);
+
+    lv_obj_t *parent = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(parent, HARNESS_HOR_RES / 2, HARNESS_VER_RES / 2);
+    page_manager_t *manager = page_manager_create_for_with_allocator(NULL, parent, &allocator);
+    TEST_CHECK(manager != NULL && manager->parent == parent);
+    TEST_CHECK(arena.used > 0);
+
+    uint8_t data[300] = {0};
+    page_stash_t stash = {data, sizeof(data)};
+    pm_install(manager, "a", &test_page);
+    pm_install(manager, "b", &test_page);
+    pm_push(manager, "a", NULL);
+    harness_run(600);
+    for (int i = 0; i < 20; i++)
+    {
+        stash.size = sizeof(data) - (uint32_t)i * 10;
+        pm_push(manager, "b", &stash);
+        harness_run(600);
+        pm_pop(manager);
+        harness_run(600);
+    }
+    TEST_CHECK(manager->stack_top->root != NULL && lv_obj_get_parent(manager->stack_top->root) == parent);
+
+    page_manager_delete(manager);
+    harness_run(100);
+    lv_obj_del(parent);
+    TEST_CHECK(arena.used == 0);
+    TEST_CHECK(arena.free_list == NULL);
+}
+
+int main(void)
+{
+    harness_init();
+    test_reuse();
+    test_realloc_null();
+    test_random();
+    test_manager_on_arena();
+    return TEST_RESULT();
+}
@@ -0,0 +1,111 @@
+/**
+ * 延迟日志测试: %s参数在写入时复制到记录中,原字符串被修改或释放后仍能还原
+ */
+#include <string.h>
+
+/* 本文件中的PM_LOG_INFO写入延迟日志 */
+#define PM_LOG_MODULE_LEVEL 0
+
+#include "page_manager.h"
+#include "test_util.h"
+
+/* 写入后修改原字符串,记录中保留写入时的内容 */
+static void test_string_copied(void)
+{
+    char name[16] = "page_a";
+    const uintptr_t args[] = {0, (uintptr_t)name, 7};
+    pm_log_write(PM_LOG_LEVEL_INFO, "page %s id %d", pm_log_str_mask("page %s id %d"), 2, args);
+    strcpy(name, "xxxxxx");
+
+    pm_log_record_t record;
+    TEST_CHECK(pm_log_read(&record));
+    TEST_CHECK(record.argc == 2);
+    TEST_CHECK(record.args[0] < PM_LOG_STR_SIZE);
+    TEST_CHECK(strcmp(record.str + record.args[0], "page_a") == 0);
+    TEST_CHECK(record.args[1] == 7);
+}
+
+/* NULL记录为PM_LOG_STR_NULL,多个字符串依次存放 */
+static void test_null_and_multiple(void)
+{
+    const uintptr_t args[] = {0, (uintptr_t)"a", 0, (uintptr_t)"bc"};
+    pm_log_write(PM_LOG_LEVEL_INFO, "%-4s %s %5s", pm_log_str_mask("%-4s %s %5s"), 3, args);
+
+    pm_log_record_t record;
+    TEST_CHECK(pm_log_read(&record));
+    TEST_CHECK(strcmp(record.str + record.args[0], "a") == 0);
+    TEST_CHECK(record.args[1] == PM_LOG_STR_NULL);
+    TEST_CHECK(strcmp(record.str + record.args[2], "bc") == 0);
+}
+
+/* 超长字符串被截断,空间用完后的字符串记录为空串 */
+static void test_truncated(void)
+{
+    char text[PM_LOG_STR_SIZE * 2];
+    memset(text, 'x', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    const uintptr_t args[] = {0, 100, (uintptr_t)text, (uintptr_t)"tail"};
+    pm_log_write(PM_LOG_LEVEL_INFO, "%d%% %s %s", pm_log_str_mask("%d%% %s %s"), 3, args);
+
+    pm_log_record_t record;
+    TEST_CHECK(pm_log_read(&record));
+    TEST_CHECK(record.args[0] == 100);
+    TEST_CHECK(strlen(record.str + record.args[1]) == PM_LOG_STR_SIZE - 1);
+    TEST_CHECK(record.args[2] < PM_LOG_STR_SIZE);
+    TEST_CHECK(record.str[record.args[2]] == '\0');
+}
+
+/* 格式化输出使用复制的字符串 */
+static void test_flush(void)
+{
+    char name[16] = "page_b";
+    const uintptr_t args[] = {0, (uintptr_t)name, 0};
+    pm_log_write(PM_LOG_LEVEL_INFO, "[test_log] flush %s %s", pm_log_str_mask("[test_log] flush %s %s"), 2, args);
+    memset(name, 0, sizeof(name));
+    TEST_CHECK(pm_log_flush() == 1);
+    TEST_CHECK(pm_log_get_dropped() == 0);
+}
+
+/* %s掩码跳过%%和标志、宽度,只统计前PM_LOG_ARG_MAX个参数 */
+static void test_str_mask(void)
+{
+    TEST_CHECK(pm_log_str_mask("no args") == 0);
+    TEST_CHECK(pm_log_str_mask("%d%% %-4s %lu %5s") == 0x0A);
+    TEST_CHECK(pm_log_str_mask("%d %d %d %d %s") == 0);
+    TEST_CHECK(pm_log_str_mask("%s") != PM_LOG_MASK_UNSET);
+}
+
+/* 宏在每个调用处缓存掩码,多次写入的记录相同 */
+static void test_macro_call_site(void)
+{
+    char name[8] = "page_c";
+    for (int i = 0; i < 2; i++)
+    {
+        PM_LOG_INFO("page %s step %d", name, i);
+    }
+    PM_LOG_INFO("no args");
+    strcpy(name, "xxxxxx");
+
+    pm_log_record_t record;
+    for (int i = 0; i < 2; i++)
+    {
+        TEST_CHECK(pm_log_read(&record));
+        TEST_CHECK(record.argc == 2);
+        TEST_CHECK(strcmp(record.str + record.args[0], "page_c") == 0);
+        TEST_CHECK(record.args[1] == (uintptr_t)i);
+    }
+    TEST_CHECK(pm_log_read(&record));
+    TEST_CHECK(record.argc == 0);
+    TEST_CHECK(!pm_log_read(&record));
+}
+
+int main(void)
+{
+    test_string_copied();
+    test_null_and_multiple();
+    test_truncated();
+    test_flush();
+    test_str_mask();
+    test_macro_call_site();
+    return TEST_RESULT();
+}
@@ -0,0 +1,341 @@
+/**
+ * 导航请求测试: 多层回退、排队和打断时的请求检查
+ */
+#include <string.h>
+
+#include "harness.h"
+#include "page_manager_private.h"
+#include "test_util.h"
+
+static void test_page_cfg(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void test_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t test_page = {
+    test_page_cfg, test_page_noop, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+static page_manager_t *test_manager_create(void)
+{
+    page_manager_t *manager = page_manager_create();
+    pm_install(manager, "home", &test_page);
+    pm_install(manager, "a", &test_page);
+    pm_install(manager, "b", &test_page);
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, 300, lv_anim_path_linear);
+    return manager;
+}
+
+static void test_manager_delete(page_manager_t *manager)
+{
+    page_manager_delete(manager);
+    harness_run(100);
+}
+
+/* 栈中不足两个页面时pm_pop_n直接返回false,不访问栈顶 */
+static void test_pop_n_shallow_stack(void)
+{
+    page_manager_t *manager = test_manager_create();
+
+    TEST_CHECK(!pm_pop_n(manager, 1));
+    TEST_CHECK(!pm_pop_n(manager, 3));
+    TEST_CHECK(!pm_pop_to(manager, "home"));
+    TEST_CHECK(manager->stack_depth == 0);
+
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    TEST_CHECK(!pm_pop_n(manager, 1));
+    TEST_CHECK(!pm_pop_n(manager, 0));
+    TEST_CHECK(manager->stack_depth == 1);
+    TEST_CHECK(manager->stack_top->root != NULL);
+
+    test_manager_delete(manager);
+}
+
+/* 打断模式下被拒绝的请求不打断正在播放的切换动画 */
+static void test_rejected_request_keeps_transition(void)
+{
+    page_manager_t *manager = test_manager_create();
+    pm_set_preempt_mode(manager, PM_PREEMPT_RETARGET);
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    pm_push(manager, "a", NULL);
+    harness_run(400);
+
+    page_base_t *b = find_page_id(manager, pm_get_page_id(manager, "b"));
+    pm_push(manager, "b", NULL);
+    harness_run(150);
+    lv_coord_t x = lv_obj_get_x(b->root);
+    TEST_CHECK(x > 0);
+
+    // a和b已在栈中,重复push被拒绝
+    pm_push(manager, "a", NULL);
+    TEST_CHECK(manager->anim_state.is_switch_req);
+    TEST_CHECK(!pm_replace(manager, "b", NULL));
+    TEST_CHECK(manager->anim_state.is_switch_req);
+    TEST_CHECK(lv_obj_get_x(b->root) == x);
+
+    harness_run(400);
+    TEST_CHECK(!manager->anim_state.is_switch_req);
+    TEST_CHECK(lv_obj_get_x(b->root) == 0);
+    TEST_CHECK(manager->stack_depth == 3);
+    TEST_CHECK(manager->stack_top == b);
+    TEST_CHECK(nav_queue_is_empty(manager));
+
+    test_manager_delete(manager);
+}
+
+static int moved_free_count;
+
+static void test_moved_free(void *ptr)
+{
+    (void)ptr;
+    moved_free_count++;
+}
+
+/* 排队的push在执行时被拒绝,它的数据块不会覆盖页面已有的数据块 */
+static void test_rejected_queued_push_stash(void)
+{
+    page_manager_t *manager = test_manager_create();
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+
+    char first[] = "first";
+    char second[] = "second";
+    static char moved[] = "moved";
+    page_stash_t stash1 = {first, sizeof(first)};
+    page_stash_t stash2 = {second, sizeof(second)};
+
+    pm_push(manager, "a", NULL);
+    pm_push(manager, "b", &stash1);
+    pm_push(manager, "b", &stash2);
+    TEST_CHECK(pm_push_move(manager, "b", moved, sizeof(moved), test_moved_free));
+    moved_free_count = 0;
+    harness_run(1000);
+
+    page_base_t *b = find_page_id(manager, pm_get_page_id(manager, "b"));
+    uint32_t size = 0;
+    const char *data = page_borrow_stash(b, &size);
+    TEST_CHECK(manager->stack_top == b);
+    TEST_CHECK(manager->stack_depth == 3);
+    TEST_CHECK(data != NULL && size == sizeof(first) && strcmp(data, first) == 0);
+    TEST_CHECK(moved_free_count == 1);
+    TEST_CHECK(nav_queue_is_empty(manager));
+
+    test_manager_delete(manager);
+}
+
+/* 执行时会被拒绝的push不与后面的pop抵消 */
+static void test_invalid_push_not_coalesced(void)
+{
+    page_manager_t *manager = test_manager_create();
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+
+    pm_push(manager, "a", NULL);
+    pm_push(manager, "b", NULL);
+    pm_push(manager, "a", NULL);
+    pm_pop(manager);
+    harness_run(1500);
+
+    TEST_CHECK(manager->stack_depth == 2);
+    TEST_CHECK(manager->stack_top == find_page_id(manager, pm_get_page_id(manager, "a")));
+    TEST_CHECK(nav_queue_is_empty(manager));
+
+    test_manager_delete(manager);
+}
+
+/* 合并的回退层数饱和,不回绕成0 */
+static void test_pop_merge_saturates(void)
+{
+    page_manager_t *manager = test_manager_create();
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    pm_push(manager, "a", NULL);
+    harness_run(400);
+    pm_push(manager, "b", NULL);
+    harness_run(100);
+
+    TEST_CHECK(pm_pop_n(manager, UINT16_MAX));
+    pm_pop(manager);
+    harness_run(1500);
+    TEST_CHECK(manager->stack_depth == 1);
+    TEST_CHECK(manager->stack_top == find_page_id(manager, pm_get_page_id(manager, "home")));
+    TEST_CHECK(nav_queue_is_empty(manager));
+
+    test_manager_delete(manager);
+}
+
+static void test_page_translucent_load(page_base_t *self)
+{
+    lv_obj_set_style_local_bg_opa(self->root, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+}
+
+static page_vtable_t test_page_translucent = {
+    test_page_cfg, test_page_translucent_load, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+/* 半透明的页面不遮挡下层页面,声明不透明后遮挡 */
+static void test_occlusion_opaque(void)
+{
+    page_manager_t *manager = test_manager_create();
+    pm_install(manager, "overlay", &test_page_translucent);
+    page_base_t *home = find_page_id(manager, pm_get_page_id(manager, "home"));
+    page_base_t *overlay = find_page_id(manager, pm_get_page_id(manager, "overlay"));
+
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    pm_push(manager, "overlay", NULL);
+    harness_run(400);
+    TEST_CHECK(!lv_obj_get_hidden(home->root));
+
+    pm_pop(manager);
+    harness_run(400);
+    page_set_custom_opaque(overlay, true);
+    pm_push(manager, "overlay", NULL);
+    harness_run(400);
+    TEST_CHECK(lv_obj_get_hidden(home->root));
+
+    pm_pop(manager);
+    harness_run(400);
+    TEST_CHECK(!lv_obj_get_hidden(home->root));
+
+    test_manager_delete(manager);
+}
+
+static bool test_page_load_step(page_base_t *self)
+{
+    lv_obj_create(self->root, NULL);
+    return true;
+}
+
+static page_vtable_t test_page_step = {
+    test_page_cfg, test_page_noop, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+    test_page_load_step,
+};
+
+/* 分帧构建期间排队的push先于打断后的pop执行 */
+static void test_preempt_keeps_queue_order(void)
+{
+    page_manager_t *manager = test_manager_create();
+    pm_install(manager, "slow", &test_page_step);
+    pm_set_preempt_mode(manager, PM_PREEMPT_FINISH);
+    page_base_t *slow = find_page_id(manager, pm_get_page_id(manager, "slow"));
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    pm_push(manager, "a", NULL);
+    harness_run(400);
+
+    pm_push(manager, "slow", NULL);
+    TEST_CHECK(PAGE_HOT_STATE(slow) == PAGE_STATE_LOADING);
+    pm_push(manager, "b", NULL);
+    TEST_CHECK(!nav_queue_is_empty(manager));
+    for (int i = 0; i < 10 && PAGE_HOT_STATE(slow) == PAGE_STATE_LOADING; i++)
+    {
+        harness_run(HARNESS_FRAME_MS);
+    }
+    TEST_CHECK(PAGE_HOT_STATE(slow) != PAGE_STATE_LOADING);
+    TEST_CHECK(manager->anim_state.is_switch_req);
+
+    // push b先执行,pop回退的是b
+    pm_pop(manager);
+    harness_run(1500);
+    TEST_CHECK(manager->stack_depth == 3);
+    TEST_CHECK(manager->stack_top == slow);
+    TEST_CHECK(nav_queue_is_empty(manager));
+
+    test_manager_delete(manager);
+}
+
+static int restore_count;
+
+static void test_page_fill_load(page_base_t *self)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        lv_obj_create(self->root, NULL);
+    }
+}
+
+static void test_page_restore(page_base_t *self)
+{
+    (void)self;
+    restore_count++;
+}
+
+static page_vtable_t test_page_fill = {
+    test_page_cfg, test_page_fill_load, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+    NULL, test_page_noop, test_page_restore,
+};
+
+/* 被淘汰的页面回退后成为栈顶下方的页面时重新加载,拖拽返回时可以露出 */
+static void test_evicted_under_page_restored(void)
+{
+    page_manager_t *manager = page_manager_create();
+    const char *names[] = {"p0", "p1", "p2", "p3"};
+    for (int i = 0; i < 4; i++)
+    {
+        pm_install(manager, names[i], &test_page_fill);
+    }
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, 300, lv_anim_path_linear);
+    pm_set_cache_budget(manager, 6);
+    for (int i = 0; i < 4; i++)
+    {
+        pm_push(manager, names[i], NULL);
+        harness_run(400);
+    }
+
+    page_base_t *p1 = find_page_pool(manager, "p1");
+    page_base_t *p2 = find_page_pool(manager, "p2");
+    TEST_CHECK(p1->root == NULL);
+    TEST_CHECK(p2->root != NULL);
+
+    restore_count = 0;
+    pm_pop(manager);
+    harness_run(400);
+    TEST_CHECK(manager->stack_top == p2);
+    TEST_CHECK(p1->root != NULL);
+    TEST_CHECK(restore_count == 1);
+    TEST_CHECK(lv_obj_get_child(lv_obj_get_parent(p2->root), p2->root) == p1->root);
+    TEST_CHECK(lv_obj_get_hidden(p1->root));
+
+    // 拖拽返回露出p1,再回退时直接显示,不再重新加载;p1下方被淘汰的p0随之重新加载
+    lv_obj_t *p1_root = p1->root;
+    lv_stub_set_indev_vect(0, 0);
+    lv_event_send(p2->root, LV_EVENT_PRESSED, NULL);
+    TEST_CHECK(!lv_obj_get_hidden(p1->root));
+    lv_event_send(p2->root, LV_EVENT_RELEASED, NULL);
+    harness_run(400);
+
+    pm_pop(manager);
+    harness_run(400);
+    TEST_CHECK(manager->stack_top == p1);
+    TEST_CHECK(p1->root == p1_root);
+    TEST_CHECK(find_page_pool(manager, "p0")->root != NULL);
+    TEST_CHECK(restore_count == 2);
+
+    test_manager_delete(manager);
+}
+
+int main(void)
+{
+    harness_init();
+    test_pop_n_shallow_stack();
+    test_rejected_request_keeps_transition();
+    test_rejected_queued_push_stash();
+    test_invalid_push_not_coalesced();
+    test_pop_merge_saturates();
+    test_occlusion_opaque();
+    test_preempt_keeps_queue_order();
+    test_evicted_under_page_restored();
+    return TEST_RESULT();
+}
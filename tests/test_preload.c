@@ -0,0 +1,173 @@
+/**
+ * 预加载测试: 分帧构建的页面按on_view_load_step切分预算,构建中可以取消或直接push
+ */
+#include "harness.h"
+#include "page_manager_private.h"
+#include "test_util.h"
+
+#define PRELOAD_STEPS 10     // 页面构建需要的步数
+#define PRELOAD_STEP_US 1000 // 每步消耗的时间
+#define PRELOAD_BUDGET_US 3000
+
+static uint32_t test_clock;
+static uint32_t test_steps;
+static uint32_t test_did_load;
+static uint32_t test_did_unload;
+
+static uint32_t test_clock_cb(void)
+{
+    return test_clock;
+}
+
+static bool test_page_load_step(page_base_t *self)
+{
+    lv_obj_create(self->root, NULL);
+    test_clock += PRELOAD_STEP_US;
+    return ++test_steps >= PRELOAD_STEPS;
+}
+
+static void test_page_did_load(page_base_t *self)
+{
+    (void)self;
+    test_did_load++;
+}
+
+static void test_page_did_unload(page_base_t *self)
+{
+    (void)self;
+    test_did_unload++;
+}
+
+static void test_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t test_page = {
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+static page_vtable_t test_page_step = {
+    test_page_noop, test_page_noop, test_page_did_load, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_did_unload,
+    test_page_load_step,
+};
+
+static page_manager_t *test_manager_create(void)
+{
+    test_steps = 0;
+    test_did_load = 0;
+    test_did_unload = 0;
+
+    page_manager_t *manager = page_manager_create();
+    pm_install(manager, "home", &test_page);
+    pm_install(manager, "big", &test_page_step);
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, 300, lv_anim_path_linear);
+    pm_set_preload_budget(manager, PRELOAD_BUDGET_US);
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    return manager;
+}
+
+static void test_manager_delete(page_manager_t *manager)
+{
+    page_manager_delete(manager);
+    harness_run(100);
+}
+
+/* 每帧只执行预算内的步数,构建完成后才调用on_view_did_load */
+static void test_preload_sliced(void)
+{
+    page_manager_t *manager = test_manager_create();
+    page_base_t *big = find_page_pool(manager, "big");
+
+    TEST_CHECK(pm_preload(manager, "big"));
+    uint32_t frames = 0;
+    uint32_t steps = 0;
+    while (big->priv.preload != PAGE_PRELOAD_DONE && frames < 100)
+    {
+        harness_run(HARNESS_FRAME_MS);
+        TEST_CHECK(test_steps - steps <= PRELOAD_BUDGET_US / PRELOAD_STEP_US);
+        TEST_CHECK(test_did_load == (big->priv.preload == PAGE_PRELOAD_DONE ? 1u : 0u));
+        steps = test_steps;
+        frames++;
+    }
+    TEST_CHECK(big->priv.preload == PAGE_PRELOAD_DONE);
+    TEST_CHECK(test_steps == PRELOAD_STEPS);
+    TEST_CHECK(manager->preload_task == NULL);
+
+    pm_push(manager, "big", NULL);
+    harness_run(400);
+    TEST_CHECK(manager->page_current == big);
+    TEST_CHECK(test_steps == PRELOAD_STEPS);
+    TEST_CHECK(test_did_load == 1);
+    TEST_CHECK(!lv_obj_get_hidden(big->root));
+
+    test_manager_delete(manager);
+}
+
+/* 构建中取消预加载,删除已创建的根对象 */
+static void test_preload_cancel_building(void)
+{
+    page_manager_t *manager = test_manager_create();
+    page_base_t *big = find_page_pool(manager, "big");
+
+    TEST_CHECK(pm_preload(manager, "big"));
+    while (test_steps == 0)
+    {
+        harness_run(HARNESS_FRAME_MS);
+    }
+    TEST_CHECK(big->priv.preload == PAGE_PRELOAD_BUILDING);
+    TEST_CHECK(big->root != NULL);
+
+    TEST_CHECK(pm_preload_cancel(manager, "big"));
+    TEST_CHECK(big->priv.preload == PAGE_PRELOAD_NONE);
+    TEST_CHECK(big->root == NULL);
+    TEST_CHECK(test_did_unload == 1);
+    TEST_CHECK(test_did_load == 0);
+
+    uint32_t steps = test_steps;
+    harness_run(200);
+    TEST_CHECK(test_steps == steps);
+    TEST_CHECK(manager->preload_task == NULL);
+
+    test_manager_delete(manager);
+}
+
+/* 构建中直接push,复用已创建的根对象继续构建 */
+static void test_preload_push_building(void)
+{
+    page_manager_t *manager = test_manager_create();
+    page_base_t *big = find_page_pool(manager, "big");
+
+    TEST_CHECK(pm_preload(manager, "big"));
+    while (test_steps == 0)
+    {
+        harness_run(HARNESS_FRAME_MS);
+    }
+    lv_obj_t *root = big->root;
+    TEST_CHECK(big->priv.preload == PAGE_PRELOAD_BUILDING);
+
+    pm_push(manager, "big", NULL);
+    harness_run(600);
+    TEST_CHECK(manager->page_current == big);
+    TEST_CHECK(big->root == root);
+    TEST_CHECK(big->priv.preload == PAGE_PRELOAD_NONE);
+    TEST_CHECK(test_steps == PRELOAD_STEPS);
+    TEST_CHECK(test_did_load == 1);
+    TEST_CHECK(!lv_obj_get_hidden(big->root));
+    TEST_CHECK(lv_obj_count_children_recursive(big->root) == PRELOAD_STEPS);
+
+    test_manager_delete(manager);
+}
+
+int main(void)
+{
+    harness_init();
+    pm_set_clock(test_clock_cb);
+    test_preload_sliced();
+    test_preload_cancel_building();
+    test_preload_push_building();
+    return TEST_RESULT();
+}
@@ -0,0 +1,478 @@
+/**
+ * 随机导航浸泡测试: push/pop/replace/返回/卸载/拖拽等请求随机混合,请求间隔随机,
+ * 大量请求落在切换动画播放期间;每次稳定后检查lvgl对象数量和页面管理器状态,
+ * 结束后检查分配器的申请和释放是否平衡
+ *
+ * 运行分为SOAK_WINDOWS个窗口,每个窗口结束时回到栈底页面并采样进程RSS、lvgl内存、
+ * 页面管理器的内存和运行状况,以及窗口内每个请求的耗时;预热窗口之后某项指标在每个窗口都增长时判定为泄漏,
+ * 最后打印各项指标和请求耗时的漂移
+ *
+ * 用法: test_soak [iterations] [seed]
+ */
+#include <stdlib.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "harness.h"
+#include "page_manager_private.h"
+#include "test_util.h"
+
+#define SOAK_PAGE_COUNT 8
+#define SOAK_CHILD_MAX 6
+#define SOAK_WINDOWS 8 // 采样窗口数,第一个窗口为预热,不参与趋势判断
+
+/* 采样指标 */
+enum
+{
+    SOAK_RSS_KB,
+    SOAK_LV_OBJS,
+    SOAK_LV_MEM_USED,
+    SOAK_LV_FRAG_PCT,
+    SOAK_ALLOC_LIVE,
+    SOAK_BYTES_USED,
+    SOAK_ROOTS,
+    SOAK_STASHES,
+    SOAK_SHARED_BUFS,
+    SOAK_POOL_FREE,
+    SOAK_METRIC_COUNT,
+};
+
+/* AddressSanitizer的隔离区暂存释放的内存,RSS持续增长,只打印不判定 */
+#if defined(__SANITIZE_ADDRESS__)
+#define SOAK_RSS_TOLERANCE UINT32_MAX
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SOAK_RSS_TOLERANCE UINT32_MAX
+#endif
+#endif
+#ifndef SOAK_RSS_TOLERANCE
+#define SOAK_RSS_TOLERANCE 1024
+#endif
+
+/* 指标名称和判定泄漏时允许的总增长量 */
+static const struct
+{
+    const char *name;
+    uint32_t tolerance;
+} soak_metrics[SOAK_METRIC_COUNT] = {
+    {"rss_kb", SOAK_RSS_TOLERANCE},
+    {"lv_objs", 0},
+    {"lv_mem_used", 0},
+    {"lv_frag_pct", 0},
+    {"alloc_live", 0},
+    {"bytes_used", 0},
+    {"roots", 0},
+    {"stashes", 0},
+    {"shared_bufs", 0},
+    {"pool_free", 0},
+};
+
+/* 一个窗口的采样 */
+typedef struct
+{
+    uint32_t value[SOAK_METRIC_COUNT]; // 窗口结束时的指标
+    uint64_t step_ns_sum;              // 窗口内请求耗时之和
+    uint64_t step_ns_max;              // 窗口内请求耗时最大值
+    uint32_t steps;                    // 窗口内请求数量
+} soak_sample_t;
+
+static const char *const page_names[SOAK_PAGE_COUNT] = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7"};
+static uint8_t stash_data[4096];
+
+/* 计数分配器,记录未释放的内存块 */
+static uint32_t alloc_live;
+static uint32_t moved_live;
+
+static void *_soak_alloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    alloc_live++;
+    return malloc(size);
+}
+
+static void _soak_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    if (ptr != NULL)
+    {
+        alloc_live--;
+    }
+    free(ptr);
+}
+
+static void *_soak_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    if (ptr == NULL)
+    {
+        alloc_live++;
+    }
+    return realloc(ptr, size);
+}
+
+static const pm_allocator_t soak_allocator = {_soak_alloc, _soak_free, _soak_realloc, NULL};
+
+static void _soak_moved_free(void *ptr)
+{
+    moved_live--;
+    free(ptr);
+}
+
+static void soak_page_cfg(page_base_t *self)
+{
+    (void)self;
+}
+
+static void soak_page_cfg_cached(page_base_t *self)
+{
+    page_set_custom_cache_enable(self, true);
+}
+
+static void soak_page_load(page_base_t *self)
+{
+    int count = 1 + rand() % SOAK_CHILD_MAX;
+    for (int i = 0; i < count; i++)
+    {
+        lv_obj_create(self->root, NULL);
+    }
+}
+
+static bool soak_page_load_step(page_base_t *self)
+{
+    lv_obj_create(self->root, NULL);
+    return rand() % 3 == 0;
+}
+
+static void soak_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t soak_pages[] = {
+    {soak_page_cfg, soak_page_load, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop},
+    {soak_page_cfg_cached, soak_page_load, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop},
+    {soak_page_cfg, soak_page_load, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop, soak_page_noop,
+     soak_page_load_step},
+};
+
+static page_vtable_t *soak_page_vtable(void)
+{
+    return &soak_pages[rand() % (sizeof(soak_pages) / sizeof(soak_pages[0]))];
+}
+
+/**
+ * @brief 等待切换和排队的请求全部完成
+ *
+ * @param manager 页面管理器对象
+ */
+static void soak_settle(page_manager_t *manager)
+{
+    for (int i = 0; i < 200 && (manager->anim_state.is_switch_req || manager->nav_queue.count > 0); i++)
+    {
+        harness_run(50);
+    }
+    harness_run(50);
+    TEST_CHECK(!manager->anim_state.is_switch_req);
+    TEST_CHECK(manager->nav_queue.count == 0);
+}
+
+/**
+ * @brief 检查稳定状态: 屏幕上的对象都属于某个页面的根对象,页面栈和热数据一致
+ *
+ * @param manager 页面管理器对象
+ */
+static void soak_check(page_manager_t *manager)
+{
+    uint32_t page_objs = 0;
+    uint16_t in_stack = 0;
+    for (uint16_t i = 0; i < PAGE_MANAGER_PAGE_MAX; i++)
+    {
+        page_base_t *base = &manager->page_table[i];
+        if (base->manager == NULL)
+        {
+            continue;
+        }
+        if (base->root != NULL)
+        {
+            page_objs += lv_obj_count_children_recursive(base->root) + 1;
+        }
+        if (PAGE_HOT_IS_IN_STACK(base))
+        {
+            in_stack++;
+        }
+        TEST_CHECK(!PAGE_HOT_IS_BUSY(base));
+    }
+
+    uint16_t depth = 0;
+    for (page_base_t *base = manager->stack_top; base != NULL; base = base->priv.stack_next)
+    {
+        TEST_CHECK(PAGE_HOT_IS_IN_STACK(base));
+        depth++;
+    }
+    TEST_CHECK(depth == manager->stack_depth);
+    TEST_CHECK(in_stack == manager->stack_depth);
+    TEST_CHECK(harness_obj_count() == page_objs);
+    TEST_CHECK(lv_stub_obj_count() == harness_obj_count() + 1);
+    if (manager->stack_top != NULL)
+    {
+        TEST_CHECK(manager->stack_top->root != NULL);
+        TEST_CHECK(PAGE_HOT_STATE(manager->stack_top) == PAGE_STATE_ACTIVITY);
+    }
+}
+
+/**
+ * @brief 执行一个随机请求
+ *
+ * @param manager 页面管理器对象
+ * @param ids 页面句柄
+ */
+static void soak_step(page_manager_t *manager, pm_page_id_t *ids)
+{
+    uint8_t index = (uint8_t)(rand() % SOAK_PAGE_COUNT);
+    const char *name = page_names[index];
+    page_stash_t stash = {stash_data, 1 + (uint32_t)(rand() % sizeof(stash_data))};
+
+    switch (rand() % 16)
+    {
+    case 0:
+    case 1:
+    case 2:
+        pm_push(manager, name, rand() % 2 ? &stash : NULL);
+        break;
+    case 3:
+        pm_push_id(manager, ids[index], NULL);
+        break;
+    case 4:
+    {
+        uint32_t size = 1 + (uint32_t)(rand() % 256);
+        void *ptr = malloc(size);
+        moved_live++;
+        if (!pm_push_move(manager, name, ptr, size, _soak_moved_free))
+        {
+            _soak_moved_free(ptr);
+        }
+        break;
+    }
+    case 5:
+    {
+        pm_shared_buf_t *buf = pm_shared_buf_create(manager, 64);
+        if (buf != NULL)
+        {
+            pm_push_shared(manager, name, buf);
+            pm_shared_buf_release(buf);
+        }
+        break;
+    }
+    case 6:
+    case 7:
+    case 8:
+        pm_pop(manager);
+        break;
+    case 9:
+        pm_pop_n(manager, (uint16_t)(1 + rand() % 3));
+        break;
+    case 10:
+        pm_pop_to(manager, name);
+        break;
+    case 11:
+        pm_replace(manager, name, rand() % 2 ? &stash : NULL);
+        break;
+    case 12:
+        pm_back_home(manager);
+        break;
+    case 13:
+        // 卸载后重新安装,旧句柄失效
+        pm_uninstall_id(manager, ids[index]);
+        if (pm_get_page_id(manager, name) == PM_PAGE_ID_INVALID)
+        {
+            pm_page_id_t id = pm_install(manager, name, soak_page_vtable());
+            TEST_CHECK(id != PM_PAGE_ID_INVALID && id != ids[index]);
+            ids[index] = id;
+        }
+        break;
+    case 14:
+        // 拖拽跨越多帧,期间执行的排队请求可能卸载被拖拽的页面,桩没有输入设备,无法在对象删除后停止发送事件
+        if (manager->stack_top != NULL && manager->stack_top->root != NULL &&
+            !manager->anim_state.is_switch_req && nav_queue_is_empty(manager))
+        {
+            harness_drag(manager->stack_top->root, (lv_coord_t)(rand() % HARNESS_HOR_RES), 0, (uint16_t)(1 + rand() % 10));
+        }
+        break;
+    case 15:
+        pm_set_preempt_mode(manager, (pm_preempt_t)(rand() % 3));
+        pm_set_global_load_anim_type(manager, (uint8_t)(LOAD_ANIM_OVER_LEFT + rand() % (LOAD_ANIM_NONE - LOAD_ANIM_OVER_LEFT + 1)),
+                                     (uint16_t)(rand() % 300), lv_anim_path_linear);
+        break;
+    }
+}
+
+/**
+ * @brief 获取进程的常驻内存
+ *
+ * @return uint32_t 常驻内存(kB),不支持的平台返回0
+ */
+static uint32_t soak_rss_kb(void)
+{
+    uint32_t rss = 0;
+#ifdef __linux__
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (file != NULL)
+    {
+        unsigned long size = 0;
+        unsigned long resident = 0;
+        if (fscanf(file, "%lu %lu", &size, &resident) == 2)
+        {
+            rss = (uint32_t)(resident * (unsigned long)sysconf(_SC_PAGESIZE) / 1024);
+        }
+        fclose(file);
+    }
+#endif
+    return rss;
+}
+
+/**
+ * @brief 回到栈底页面,在相同的状态下采样各项指标
+ *
+ * @param manager 页面管理器对象
+ * @param sample [out]采样
+ */
+static void soak_sample(page_manager_t *manager, soak_sample_t *sample)
+{
+    pm_back_home(manager);
+    soak_settle(manager);
+    soak_check(manager);
+
+    pm_health_t health;
+    pm_alloc_stat_t alloc_stat;
+    lv_mem_monitor_t mem;
+    pm_get_health(manager, &health);
+    pm_get_alloc_stat(manager, &alloc_stat);
+    lv_mem_monitor(&mem);
+
+    sample->value[SOAK_RSS_KB] = soak_rss_kb();
+    sample->value[SOAK_LV_OBJS] = harness_obj_count();
+    sample->value[SOAK_LV_MEM_USED] = mem.total_size - mem.free_size;
+    sample->value[SOAK_LV_FRAG_PCT] = mem.frag_pct;
+    sample->value[SOAK_ALLOC_LIVE] = alloc_live;
+    sample->value[SOAK_BYTES_USED] = alloc_stat.bytes_used;
+    sample->value[SOAK_ROOTS] = health.root_count;
+    sample->value[SOAK_STASHES] = health.stash_count;
+    sample->value[SOAK_SHARED_BUFS] = health.shared_buf_count;
+    sample->value[SOAK_POOL_FREE] = health.stash_pool_free;
+}
+
+/**
+ * @brief 检查预热之后的指标趋势并打印漂移
+ *  @note 指标在每个窗口都比上一个窗口大,且总增长超过允许值时判定为泄漏;
+ *        有界的指标(如缓存页面数量)增长到上限后不再变化,不会被误判
+ *
+ * @param samples 各窗口的采样
+ * @param count 窗口数量
+ */
+static void soak_report(const soak_sample_t *samples, uint32_t count)
+{
+    const soak_sample_t *first = &samples[1];
+    const soak_sample_t *last = &samples[count - 1];
+
+    for (int m = 0; m < SOAK_METRIC_COUNT; m++)
+    {
+        bool is_rising = count > 2;
+        for (uint32_t w = 2; w < count; w++)
+        {
+            is_rising = is_rising && samples[w].value[m] > samples[w - 1].value[m];
+        }
+        bool is_leak = is_rising && last->value[m] - first->value[m] > soak_metrics[m].tolerance;
+        printf("soak: %-12s %10u -> %10u%s\n", soak_metrics[m].name, (unsigned int)first->value[m],
+               (unsigned int)last->value[m], is_leak ? "  LEAK: grows every window" : "");
+        TEST_CHECK(!is_leak);
+    }
+
+    for (uint32_t w = 1; w < count; w++)
+    {
+        const soak_sample_t *sample = &samples[w];
+        printf("soak: window %u step latency mean %6.0f ns, max %8.0f ns\n", (unsigned int)w,
+               sample->steps ? (double)sample->step_ns_sum / sample->steps : 0.0, (double)sample->step_ns_max);
+    }
+    double first_mean = first->steps ? (double)first->step_ns_sum / first->steps : 0.0;
+    double last_mean = last->steps ? (double)last->step_ns_sum / last->steps : 0.0;
+    printf("soak: step latency drift %+.1f%% (window 1 -> %u)\n",
+           first_mean > 0 ? (last_mean - first_mean) * 100.0 / first_mean : 0.0, (unsigned int)(count - 1));
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000;
+    unsigned int seed = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 0) : 1;
+    pm_page_id_t ids[SOAK_PAGE_COUNT];
+    soak_sample_t samples[SOAK_WINDOWS] = {0};
+    uint32_t window_size = iterations / SOAK_WINDOWS > 0 ? iterations / SOAK_WINDOWS : 1;
+    uint32_t window = 0;
+
+    srand(seed);
+    harness_init();
+    page_manager_t *manager = page_manager_create_with_allocator(&soak_allocator);
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, 200, lv_anim_path_linear);
+    for (uint8_t i = 0; i < SOAK_PAGE_COUNT; i++)
+    {
+        ids[i] = pm_install(manager, page_names[i], soak_page_vtable());
+    }
+    pm_push(manager, page_names[0], NULL);
+    soak_settle(manager);
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        uint64_t start = harness_now_ns();
+        soak_step(manager, ids);
+        uint64_t elapsed = harness_now_ns() - start;
+        if (window < SOAK_WINDOWS)
+        {
+            soak_sample_t *sample = &samples[window];
+            sample->step_ns_sum += elapsed;
+            sample->step_ns_max = elapsed > sample->step_ns_max ? elapsed : sample->step_ns_max;
+            sample->steps++;
+        }
+
+        harness_run((uint32_t)(rand() % 200));
+        if (i % 50 == 49)
+        {
+            soak_settle(manager);
+            soak_check(manager);
+        }
+        if (i % window_size == window_size - 1 && window < SOAK_WINDOWS)
+        {
+            soak_sample(manager, &samples[window]);
+            window++;
+        }
+        if (test_failures > 0)
+        {
+            fprintf(stderr, "seed %u failed at iteration %u\n", seed, (unsigned int)i);
+            break;
+        }
+    }
+
+    soak_settle(manager);
+    pm_back_home(manager);
+    soak_settle(manager);
+    soak_check(manager);
+    if (test_failures == 0 && window > 1)
+    {
+        soak_report(samples, window);
+    }
+
+    pm_health_t health;
+    pm_get_health(manager, &health);
+    TEST_CHECK(health.stack_depth == 1);
+    // 共享数据块只能由持有数据块的页面引用
+    TEST_CHECK(health.shared_buf_count <= health.stash_count);
+
+    page_manager_delete(manager);
+    harness_run(100);
+    TEST_CHECK(alloc_live == 0);
+    TEST_CHECK(moved_live == 0);
+    TEST_CHECK(lv_stub_obj_count() == 1);
+    TEST_CHECK(lv_stub_anim_count() == 0);
+
+    printf("soak: %u iterations, seed %u, %s\n", (unsigned int)iterations, seed, test_failures ? "FAILED" : "ok");
+    return TEST_RESULT();
+}
@@ -0,0 +1,110 @@
+/**
+ * trace测试: 按下丢失时结束拖拽事件,页面名称按JSON转义
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "harness.h"
+#include "test_util.h"
+
+#define TRACE_PATH "test_trace.json"
+#define TRACE_PAGE_NAME "a\"b\\c\n"
+
+static void test_page_noop(page_base_t *self)
+{
+    (void)self;
+}
+
+static page_vtable_t test_page = {
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+    test_page_noop, test_page_noop, test_page_noop, test_page_noop,
+};
+
+/**
+ * @brief 读取trace文件
+ *
+ * @return char* 文件内容,由调用者释放,失败时返回NULL
+ */
+static char *test_trace_read(void)
+{
+    FILE *file = fopen(TRACE_PATH, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = calloc(1, (size_t)size + 1);
+    if (text != NULL && fread(text, 1, (size_t)size, file) != (size_t)size)
+    {
+        free(text);
+        text = NULL;
+    }
+    fclose(file);
+    return text;
+}
+
+/**
+ * @brief 统计子串出现的次数
+ *
+ * @param text 文本
+ * @param sub 子串
+ * @return uint32_t 出现次数
+ */
+static uint32_t test_count(const char *text, const char *sub)
+{
+    uint32_t count = 0;
+    for (const char *p = strstr(text, sub); p != NULL; p = strstr(p + 1, sub))
+    {
+        count++;
+    }
+    return count;
+}
+
+/* 按下丢失时结束拖拽,之后再收到松开事件不重复记录 */
+static void test_drag_press_lost(void)
+{
+    page_manager_t *manager = page_manager_create();
+    pm_install(manager, "home", &test_page);
+    pm_install(manager, TRACE_PAGE_NAME, &test_page);
+    pm_set_global_load_anim_type(manager, LOAD_ANIM_OVER_LEFT, 300, lv_anim_path_linear);
+    pm_push(manager, "home", NULL);
+    harness_run(400);
+    pm_push(manager, TRACE_PAGE_NAME, NULL);
+    harness_run(400);
+
+    TEST_CHECK(pm_trace_start(TRACE_PATH));
+    lv_obj_t *root = manager->stack_top->root;
+    lv_stub_set_indev_vect(0, 0);
+    lv_event_send(root, LV_EVENT_PRESSED, NULL);
+    lv_event_send(root, LV_EVENT_PRESS_LOST, NULL);
+    harness_run(400);
+    lv_event_send(root, LV_EVENT_PRESSED, NULL);
+    lv_event_send(root, LV_EVENT_PRESS_LOST, NULL);
+    lv_event_send(root, LV_EVENT_RELEASED, NULL);
+    harness_run(400);
+    pm_trace_stop();
+
+    char *text = test_trace_read();
+    TEST_CHECK(text != NULL);
+    if (text != NULL)
+    {
+        TEST_CHECK(test_count(text, "\"ph\":\"B\",\"cat\":\"drag\"") == 2);
+        TEST_CHECK(test_count(text, "\"ph\":\"E\",\"cat\":\"drag\"") == 2);
+        TEST_CHECK(strstr(text, "\"page\":\"a\\\"b\\\\c\\u000a\"") != NULL);
+        TEST_CHECK(strstr(text, TRACE_PAGE_NAME) == NULL);
+        free(text);
+    }
+    remove(TRACE_PATH);
+
+    page_manager_delete(manager);
+    harness_run(100);
+}
+
+int main(void)
+{
+    harness_init();
+    test_drag_press_lost();
+    return TEST_RESULT();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdio.h>
+
+/* 测试断言: 失败时打印位置并计数,测试结束时由TEST_RESULT()返回进程返回值 */
+
+static int test_failures;
+
+#define TEST_CHECK(cond)                                                             \
+    do                                                                               \
+    {                                                                                \
+        if (!(cond))                                                                 \
+        {                                                                            \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++;                                                         \
+        }                                                                            \
+    } while (0)
+
+#define TEST_RESULT() (test_failures == 0 ? 0 : 1)